@@ -22,7 +22,8 @@ namespace argonishche {
         SSE2 = 1,       /// SSE2 optimized version
         SSSE3 = 2,      /// SSSE3 optimized version
         SSE41 = 3,      /// SSE4.1 optimized version
-        AVX2 = 4        /// AVX2 optimized version
+        AVX2 = 4,       /// AVX2 optimized version
+        AVX512 = 5      /// AVX-512 (F and VL) optimized version
     };
 
     class Utils {
@@ -120,6 +121,49 @@ namespace argonishche {
          * @return memory buffer size
          */
         virtual size_t GetMemorySize() const = 0;
+
+        /**
+         * Applies Argon2 algorithm to several passwords at once.
+         * AVX2 and AVX-512 versions compute GetBatchSize() hashes in one register set, one hash per 64-bit SIMD lane,
+         * so they need GetBatchSize() times more memory than Hash does. The other versions hash the passwords one by one.
+         * @param pwd array of count passwords
+         * @param pwdlen array of count password lengths
+         * @param salt array of count salts
+         * @param saltlen array of count salt lengths
+         * @param out array of count output buffers
+         * @param outlen output length (the same for all the hashes)
+         * @param count the number of passwords
+         * @param aad additional authenticated data (optional, the same for all the hashes)
+         * @param aadlen additional authenticated data length (optional)
+         */
+        virtual void HashBatch(const uint8_t* const* pwd, const uint32_t* pwdlen,
+                               const uint8_t* const* salt, const uint32_t* saltlen,
+                               uint8_t* const* out, uint32_t outlen, size_t count,
+                               const uint8_t* aad = nullptr, uint32_t aadlen = 0) const = 0;
+
+        /**
+         * Applies Argon2 algorithm to several passwords at once and compares the results with the hash values
+         * @param pwd array of count passwords
+         * @param pwdlen array of count password lengths
+         * @param salt array of count salts
+         * @param saltlen array of count salt lengths
+         * @param hash array of count hash values to compare with
+         * @param hashlen hash value length (the same for all the hashes)
+         * @param result array of count verification results
+         * @param count the number of passwords
+         * @param aad additional authenticated data (optional, the same for all the hashes)
+         * @param aadlen additional authenticated data length (optional)
+         */
+        virtual void VerifyBatch(const uint8_t* const* pwd, const uint32_t* pwdlen,
+                                 const uint8_t* const* salt, const uint32_t* saltlen,
+                                 const uint8_t* const* hash, uint32_t hashlen, bool* result, size_t count,
+                                 const uint8_t* aad = nullptr, uint32_t aadlen = 0) const = 0;
+
+        /**
+         * The function returns the number of hashes HashBatch computes in parallel
+         * @return batch size (1 if the instruction set has no batch version)
+         */
+        virtual uint32_t GetBatchSize() const = 0;
     };
 
     /**
@@ -203,6 +247,31 @@ namespace argonishche {
         virtual void Final(void *out, size_t outlen) = 0;
     };
 
+    /**
+     * Interface for Blake2B instances that hash several independent messages at once
+     */
+    class Blake2MultiBase {
+    public:
+        virtual ~Blake2MultiBase() { }
+        /**
+         * Calculates hash values of count independent messages.
+         * The messages are split into groups of GetLanes() ones, each group is hashed in parallel
+         * with one SIMD lane per message. The messages can be of different length.
+         * @param in array of count pointers to messages
+         * @param inlen array of count message lengths
+         * @param out array of count pointers to output buffers, each one must be at least outlen bytes long
+         * @param count the number of messages
+         * @throws std::invalid_argument if some message or output buffer is null
+         */
+        virtual void Hash(const uint8_t* const* in, const size_t* inlen, uint8_t* const* out, size_t count) const = 0;
+
+        /**
+         * The function returns the number of messages hashed in parallel
+         * @return the number of SIMD lanes
+         */
+        virtual uint32_t GetLanes() const = 0;
+    };
+
     /**
      * A factory that creates Blake2B instances optimized for different instruction sets
      */
@@ -238,6 +307,32 @@ namespace argonishche {
         std::unique_ptr<Blake2Base> Create(InstructionSet instructionSet, size_t outlen = 32,
                                            const uint8_t* key = nullptr, size_t keylen = 0) const;
 
+        /**
+         * Creates an instance of multi-buffer Blake2B that hashes several messages at once.
+         * The optimisation is selected automatically based on the cpuid instruction output.
+         * @param outlen the output length of every hash value
+         * @param key a secret key to make Blake2B work as a keyed hash function (the same for all the messages)
+         * @param keylen the secret key length
+         * @throws std::runtime_error if parameters are wrong
+         * @return returns an unique_ptr containing multi-buffer Blake2B instance
+         */
+        std::unique_ptr<Blake2MultiBase> CreateMulti(size_t outlen = 32, const uint8_t* key = nullptr,
+                                                     size_t keylen = 0) const;
+
+        /**
+         * Creates an instance of multi-buffer Blake2B optimized for the particular instruction set.
+         * Only AVX2 (4 lanes) and AVX-512 (8 lanes) versions are vectorized,
+         * the other instruction sets get the reference implementation.
+         * @param instructionSet instruction set
+         * @param outlen the output length of every hash value
+         * @param key a secret key to make Blake2B work as a keyed hash function (the same for all the messages)
+         * @param keylen the secret key length
+         * @throws std::runtime_error if parameters are wrong
+         * @return returns an unique_ptr containing multi-buffer Blake2B instance
+         */
+        std::unique_ptr<Blake2MultiBase> CreateMulti(InstructionSet instructionSet, size_t outlen = 32,
+                                                     const uint8_t* key = nullptr, size_t keylen = 0) const;
+
         /**
          * The function returns the best instruction set available on the current CPU
          * @return InstructionSet value
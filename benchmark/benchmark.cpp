@@ -332,6 +332,8 @@ int main(int argc, char** argv)
                                    cnf.tcost, cnf.mcost, cnf.threads, cnf.fork);
     Argon2Benchmark benchmarkAvx2(InstructionSet::AVX2, cnf.type,
                                   cnf.tcost, cnf.mcost, cnf.threads, cnf.fork);
+    Argon2Benchmark benchmarkAvx512(InstructionSet::AVX512, cnf.type,
+                                    cnf.tcost, cnf.mcost, cnf.threads, cnf.fork);
 
     InstructionSet best = cpuid::CpuId::GetBestSet();
 
@@ -366,6 +368,11 @@ int main(int argc, char** argv)
         benchmarkAvx2.Run();
     }
 
+    if(best >= InstructionSet::AVX512) {
+        std::cout << "[~] Running AVX512..." << std::endl;
+        benchmarkAvx512.Run();
+    }
+
     std::stringstream json;
     json << "{" << std::endl;
 
@@ -400,6 +407,13 @@ int main(int argc, char** argv)
         json << "," << std::endl;
         benchmarkAvx2.AddJson(json);
     }
+
+    if(best >= InstructionSet::AVX512) {
+        std::cout << "----AVX512---" << std::endl;
+        benchmarkAvx512.PrintResults();
+        json << "," << std::endl;
+        benchmarkAvx512.AddJson(json);
+    }
     json << std::endl << "}" << std::endl;
 
     if (cnf.json_filename != nullptr) {
@@ -28,7 +28,7 @@ namespace cpuid {
 #endif
     }
 
-    static int check_xcr0_ymm()
+    static int get_xcr0()
     {
         int xcr0;
 #if defined(_MSC_VER)
@@ -36,9 +36,22 @@ namespace cpuid {
 #else
         __asm__ ("xgetbv" : "=a" (xcr0) : "c" (0) : "%edx" );
 #endif
+        return xcr0;
+    }
+
+    static int check_xcr0_ymm()
+    {
+        int xcr0 = get_xcr0();
         return ((xcr0 & 6) == 6); /* checking if xmm and ymm state are enabled in XCR0 */
     }
 
+    static int check_xcr0_zmm()
+    {
+        int xcr0 = get_xcr0();
+        /* checking if xmm, ymm, opmask, upper halves of zmm0-15 and zmm16-31 state are enabled in XCR0 */
+        return ((xcr0 & 0xe6) == 0xe6);
+    }
+
     CpuId::CpuId(int eax) {
         run_cpuid(eax, 0, regs);
     }
@@ -87,6 +100,18 @@ namespace cpuid {
         return (cpuidLzcnt.ECX() & (1 << 5)) != 0;
     }
 
+    /* AVX-512VL is required as well since 256-bit rotations are used in Blake2B */
+    bool CpuId::HasAVX512FVL() {
+        if (!HasAVX2BMI12())
+            return false;
+
+        if (!check_xcr0_zmm())
+            return false;
+
+        CpuId cpuidavx512(7); /* Extended Features */
+        return (cpuidavx512.EBX() & CpuId::FlagAVX512FVL) == CpuId::FlagAVX512FVL;
+    }
+
     bool CpuId::HasSSE41() {
         CpuId cpuid1(1); /* Feature bits */
         return ((cpuid1.ECX() & CpuId::FlagSSE41) == CpuId::FlagSSE41);
@@ -108,6 +133,9 @@ namespace cpuid {
     }
 
     argonishche::InstructionSet CpuId::GetBestSet() {
+        if(HasAVX512FVL())
+            return argonishche::InstructionSet::AVX512;
+
         /* On Intel CPUs AVX2 comes with BMI2 */
         if(HasAVX2BMI12())
             return argonishche::InstructionSet::AVX2;
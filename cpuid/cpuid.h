@@ -15,6 +15,7 @@ namespace cpuid {
         const int& EDX() const;
 
         static constexpr int FlagAVX2BMI12 =  (1 << 5) | (1 << 3) | (1 << 8);
+        static constexpr int FlagAVX512FVL = (1 << 16) | (1 << 31);
         static constexpr int FlagFMAMOVBEOSXSAVE = ((1 << 12) | (1 << 22) | (1 << 27));
         static constexpr int FlagSSE41 = 1 << 19;
         static constexpr int FlagSSE42 = 1 << 20;
@@ -24,6 +25,7 @@ namespace cpuid {
     public:
         static std::string GetVendor();
         static argonishche::InstructionSet GetBestSet();
+        static bool HasAVX512FVL();
         static bool HasAVX2BMI12();
         static bool HasSSE41();
         static bool HasSSE42();
@@ -1,4 +1,5 @@
 #include <cstring>
+#include <stdexcept>
 
 #include "argonishche.h"
 #include "cpuid/cpuid.h"
@@ -8,6 +9,7 @@
 #include "internal/proxies/ssse3/proxy_ssse3.h"
 #include "internal/proxies/sse41/proxy_sse41.h"
 #include "internal/proxies/avx2/proxy_avx2.h"
+#include "internal/proxies/avx512/proxy_avx512.h"
 
 namespace argonishche {
     Argon2Factory::Argon2Factory(bool skipTest) {
@@ -29,6 +31,8 @@ namespace argonishche {
                 return std::make_unique<Argon2ProxySSSE3>(atype, tcost, mcost, threads, key, keylen);
             case InstructionSet::AVX2:
                 return std::make_unique<Argon2ProxyAVX2>(atype, tcost, mcost, threads, key, keylen);
+            case InstructionSet::AVX512:
+                return std::make_unique<Argon2ProxyAVX512>(atype, tcost, mcost, threads, key, keylen);
         }
 
         /* to avoid gcc warning  */
@@ -112,6 +116,15 @@ namespace argonishche {
                     throw std::runtime_error("Argon2 runtime test fail");
             }
         }
+
+        if(instructionSet__ >= InstructionSet::AVX512){
+            for (uint32_t atype = (uint32_t) Argon2Type::Argon2_d; atype <= (uint32_t) Argon2Type::Argon2_id; ++atype) {
+                auto argon2d = std::make_unique<Argon2ProxyAVX512>((Argon2Type)atype, 1, 1024, 1);
+                argon2d->Hash(password, sizeof(password), salt, sizeof(salt), hash_result, sizeof(hash_result));
+                if (memcmp(test_result[atype], hash_result, sizeof(hash_result)) != 0)
+                    throw std::runtime_error("Argon2 runtime test fail");
+            }
+        }
     }
 
     Blake2BFactory::Blake2BFactory(bool skipTest) {
@@ -133,6 +146,8 @@ namespace argonishche {
                 return std::make_unique<Blake2BProxySSE41>(outlen, key, keylen);
             case InstructionSet::AVX2:
                 return std::make_unique<Blake2BProxyAVX2>(outlen, key, keylen);
+            case InstructionSet::AVX512:
+                return std::make_unique<Blake2BProxyAVX512>(outlen, key, keylen);
         }
 
         /* to supress gcc warning */
@@ -143,6 +158,28 @@ namespace argonishche {
         return Create(instructionSet__, outlen, key, keylen);
     }
 
+    std::unique_ptr<Blake2MultiBase> Blake2BFactory::CreateMulti(InstructionSet instructionSet, size_t outlen,
+                                                                 const uint8_t *key, size_t keylen) const {
+        switch(instructionSet) {
+            case InstructionSet::REF:
+            case InstructionSet::SSE2:
+            case InstructionSet::SSSE3:
+            case InstructionSet::SSE41:
+                return std::make_unique<Blake2BMultiProxyREF>(outlen, key, keylen);
+            case InstructionSet::AVX2:
+                return std::make_unique<Blake2BMultiProxyAVX2>(outlen, key, keylen);
+            case InstructionSet::AVX512:
+                return std::make_unique<Blake2BMultiProxyAVX512>(outlen, key, keylen);
+        }
+
+        /* to supress gcc warning */
+        throw std::runtime_error("Invalid instruction set");
+    }
+
+    std::unique_ptr<Blake2MultiBase> Blake2BFactory::CreateMulti(size_t outlen, const uint8_t *key, size_t keylen) const {
+        return CreateMulti(instructionSet__, outlen, key, keylen);
+    }
+
     InstructionSet Blake2BFactory::GetInstructionSet() const {
         return instructionSet__;
     }
@@ -194,5 +231,37 @@ namespace argonishche {
             if(memcmp(test_result, hash_val, 16) != 0)
                 throw std::runtime_error("Blake2B runtime test fail");
         }
+
+        if(instructionSet__ >= InstructionSet::AVX512) {
+            auto blake2 = std::make_unique<Blake2BProxyAVX512>(16);
+            blake2->Update(test_str, 3);
+            blake2->Final(hash_val, 16);
+            if(memcmp(test_result, hash_val, 16) != 0)
+                throw std::runtime_error("Blake2B runtime test fail");
+        }
+
+        const uint8_t* multi_in[] = {(const uint8_t*)test_str};
+        const size_t multi_inlen[] = {3};
+        uint8_t* multi_out[] = {hash_val};
+        {
+            auto blake2 = std::make_unique<Blake2BMultiProxyREF>(16);
+            blake2->Hash(multi_in, multi_inlen, multi_out, 1);
+            if(memcmp(test_result, hash_val, 16) != 0)
+                throw std::runtime_error("Blake2B multi-buffer runtime test fail");
+        }
+
+        if(instructionSet__ >= InstructionSet::AVX2) {
+            auto blake2 = std::make_unique<Blake2BMultiProxyAVX2>(16);
+            blake2->Hash(multi_in, multi_inlen, multi_out, 1);
+            if(memcmp(test_result, hash_val, 16) != 0)
+                throw std::runtime_error("Blake2B multi-buffer runtime test fail");
+        }
+
+        if(instructionSet__ >= InstructionSet::AVX512) {
+            auto blake2 = std::make_unique<Blake2BMultiProxyAVX512>(16);
+            blake2->Hash(multi_in, multi_inlen, multi_out, 1);
+            if(memcmp(test_result, hash_val, 16) != 0)
+                throw std::runtime_error("Blake2B multi-buffer runtime test fail");
+        }
     }
 }
@@ -1,8 +1,8 @@
 #include "argonishche.h"
 
 namespace argonishche {
-    static const char* const InstructionSetStrings[5] = {
-            "REF", "SSE2", "SSSE3", "SSE41", "AVX2"
+    static const char* const InstructionSetStrings[6] = {
+            "REF", "SSE2", "SSSE3", "SSE41", "AVX2", "AVX512"
     };
 
     static const char* const Argon2TypeStrings[3] = {
@@ -6,14 +6,17 @@
 
 namespace argonishche {
 
-    template<uint32_t mcost, uint32_t threads>
-    class Argon2AVX2 final : public Argon2<InstructionSet::AVX2, mcost, threads> {
+    template<Argon2Type atype, uint32_t mcost, uint32_t threads>
+    class Argon2AVX2 final : public Argon2<Argon2AVX2<atype, mcost, threads>, InstructionSet::AVX2, atype, mcost, threads> {
+        using Base = Argon2<Argon2AVX2<atype, mcost, threads>, InstructionSet::AVX2, atype, mcost, threads>;
+        friend Base;
+
     public:
-        Argon2AVX2(Argon2Type atype, uint32_t tcost, const uint8_t* key, uint32_t keylen)
-                : Argon2<InstructionSet::AVX2, mcost, threads>(atype, tcost, key, keylen) { }
+        Argon2AVX2(uint32_t tcost, const uint8_t* key, uint32_t keylen)
+                : Base(tcost, key, keylen) { }
 
     protected:
-        virtual void xor_block__(block *dst, const block *src) const override {
+        void xor_block__(block *dst, const block *src) const {
             __m256i* mdst = (__m256i*)dst;
             __m256i* msrc = (__m256i*)src;
 
@@ -21,11 +24,13 @@ namespace argonishche {
                 xor_values(mdst + i, mdst + i, msrc + i);
         }
 
-        virtual void copy_block__(block *dst, const block *src) const override {
+        void copy_block__(block *dst, const block *src) const {
             memcpy(dst->v, src->v, sizeof(uint64_t) * ARGON2_QWORDS_IN_BLOCK);
         }
 
-        virtual void fill_block__(const block *prev_block, const block *ref_block, block *next_block, bool with_xor) const override {
+        template <class FirstWordCallback = Argon2IgnoreFirstWord>
+        void fill_block__(const block *prev_block, const block *ref_block, block *next_block, bool with_xor,
+                          FirstWordCallback first_word = FirstWordCallback()) const {
             __m256i block_XY[ARGON2_HWORDS_IN_BLOCK];
             __m256i state[ARGON2_HWORDS_IN_BLOCK];
 
@@ -118,6 +123,10 @@ namespace argonishche {
                         state[16 + i], state[20 + i],
                         state[24 + i], state[28 + i]
                 );
+
+                /* state[0] is final after the first columns, report the first word before the rest is done */
+                if (i == 0)
+                    first_word((uint64_t)_mm_cvtsi128_si64(_mm256_castsi256_si128(_mm256_xor_si256(state[0], block_XY[0]))));
             }
 
             for (uint32_t i = 0; i < ARGON2_HWORDS_IN_BLOCK; ++i) {
@@ -125,5 +134,54 @@ namespace argonishche {
                 _mm256_storeu_si256((__m256i *) next_block->v + i, state[i]);
             }
         }
+
+        uint32_t batch_width__() const {
+            return 4;
+        }
+
+        void fill_block_batch__(const uint64_t *prev_block, const uint64_t *ref_block,
+                                uint64_t *next_block, bool with_xor) const {
+            const __m256i* prev = (const __m256i*)prev_block;
+            const __m256i* ref = (const __m256i*)ref_block;
+            __m256i* next = (__m256i*)next_block;
+            __m256i block_XY[ARGON2_QWORDS_IN_BLOCK];
+            __m256i state[ARGON2_QWORDS_IN_BLOCK];
+
+            for (uint32_t i = 0; i < ARGON2_QWORDS_IN_BLOCK; ++i) {
+                state[i] = _mm256_xor_si256(_mm256_loadu_si256(prev + i), _mm256_loadu_si256(ref + i));
+                block_XY[i] = with_xor ? _mm256_xor_si256(state[i], _mm256_loadu_si256(next + i)) : state[i];
+            }
+
+            /* the same permutation as in the reference version but every qword is a register */
+            for (uint32_t i = 0; i < 8; ++i) {
+                BLAMKA_ROUND_BATCH_AVX2(
+                        state[16 * i +  0], state[16 * i +  1], state[16 * i +  2], state[16 * i +  3],
+                        state[16 * i +  4], state[16 * i +  5], state[16 * i +  6], state[16 * i +  7],
+                        state[16 * i +  8], state[16 * i +  9], state[16 * i + 10], state[16 * i + 11],
+                        state[16 * i + 12], state[16 * i + 13], state[16 * i + 14], state[16 * i + 15]);
+            }
+
+            for (uint32_t i = 0; i < 8; ++i) {
+                BLAMKA_ROUND_BATCH_AVX2(
+                        state[2 * i +  0], state[2 * i +  1], state[2 * i +  16], state[2 * i +  17],
+                        state[2 * i + 32], state[2 * i + 33], state[2 * i +  48], state[2 * i +  49],
+                        state[2 * i + 64], state[2 * i + 65], state[2 * i +  80], state[2 * i +  81],
+                        state[2 * i + 96], state[2 * i + 97], state[2 * i + 112], state[2 * i + 113]);
+            }
+
+            for (uint32_t i = 0; i < ARGON2_QWORDS_IN_BLOCK; ++i)
+                _mm256_storeu_si256(next + i, _mm256_xor_si256(state[i], block_XY[i]));
+        }
+
+        void fill_block_batch_gather__(const uint64_t *prev_block, const uint64_t *memory, const uint64_t *ref_offsets,
+                                       uint64_t *next_block, bool with_xor) const {
+            __m256i ref_block[ARGON2_QWORDS_IN_BLOCK];
+            const __m256i offsets = _mm256_loadu_si256((const __m256i*)ref_offsets);
+
+            for (uint32_t i = 0; i < ARGON2_QWORDS_IN_BLOCK; ++i)
+                ref_block[i] = _mm256_i64gather_epi64((const long long int*)(memory + 4 * i), offsets, 8);
+
+            fill_block_batch__(prev_block, (const uint64_t*)ref_block, next_block, with_xor);
+        }
     };
 }
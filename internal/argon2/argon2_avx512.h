@@ -0,0 +1,176 @@
+#pragma once
+
+#include <immintrin.h>
+#include "argon2_base.h"
+#include "internal/blamka/blamka_avx512.h"
+
+namespace argonishche {
+
+    template<Argon2Type atype, uint32_t mcost, uint32_t threads>
+    class Argon2AVX512 final : public Argon2<Argon2AVX512<atype, mcost, threads>, InstructionSet::AVX512, atype, mcost, threads> {
+        using Base = Argon2<Argon2AVX512<atype, mcost, threads>, InstructionSet::AVX512, atype, mcost, threads>;
+        friend Base;
+
+    public:
+        Argon2AVX512(uint32_t tcost, const uint8_t* key, uint32_t keylen)
+                : Base(tcost, key, keylen) { }
+
+    protected:
+        void xor_block__(block *dst, const block *src) const {
+            __m512i* mdst = (__m512i*)dst;
+            __m512i* msrc = (__m512i*)src;
+
+            for(uint32_t i = 0; i < ARGON2_ZWORDS_IN_BLOCK; ++i)
+                xor_values(mdst + i, mdst + i, msrc + i);
+        }
+
+        void copy_block__(block *dst, const block *src) const {
+            memcpy(dst->v, src->v, sizeof(uint64_t) * ARGON2_QWORDS_IN_BLOCK);
+        }
+
+        template <class FirstWordCallback = Argon2IgnoreFirstWord>
+        void fill_block__(const block *prev_block, const block *ref_block, block *next_block, bool with_xor,
+                          FirstWordCallback first_word = FirstWordCallback()) const {
+            __m512i state[ARGON2_ZWORDS_IN_BLOCK];
+
+            for (uint32_t i = 0; i < ARGON2_ZWORDS_IN_BLOCK; ++i)
+                state[i] = _mm512_loadu_si512((const __m512i *) prev_block->v + i);
+
+            fill_block_state__(state, ref_block, next_block, with_xor, first_word);
+        }
+
+        /**
+         * The whole block fits in 16 of 32 zmm registers, so the previous block is carried over
+         * from one iteration to the next instead of being stored and loaded back
+         */
+        template <class RefBlock>
+        void fill_blocks__(const block *prev_block, block *next_block, uint32_t count, bool with_xor,
+                           RefBlock ref_block) const {
+            __m512i state[ARGON2_ZWORDS_IN_BLOCK];
+
+            for (uint32_t i = 0; i < ARGON2_ZWORDS_IN_BLOCK; ++i)
+                state[i] = _mm512_loadu_si512((const __m512i *) prev_block->v + i);
+
+            const block* ref = ref_block(0, prev_block->v[0]);
+
+            for (uint32_t k = 0; k < count; ++k) {
+                const block* next_ref = nullptr;
+                auto first_word = [&](uint64_t pseudo_rand) {
+                    if (k + 1 < count)
+                        next_ref = ref_block(k + 1, pseudo_rand);
+                };
+                fill_block_state__(state, ref, next_block + k, with_xor, first_word);
+                ref = next_ref;
+            }
+        }
+
+        /**
+         * Takes the previous block in state and leaves the new one there.
+         * Inside the loop of fill_blocks__ GCC doesn't unroll these loops by itself and keeps state on the stack
+         */
+        template <class FirstWordCallback>
+        inline __attribute__((always_inline)) void fill_block_state__(
+                __m512i state[ARGON2_ZWORDS_IN_BLOCK], const block *ref_block, block *next_block, bool with_xor,
+                FirstWordCallback& first_word) const {
+            __m512i block_XY[ARGON2_ZWORDS_IN_BLOCK];
+
+            if (with_xor) {
+                #pragma GCC unroll 16
+                for (uint32_t i = 0; i < ARGON2_ZWORDS_IN_BLOCK; ++i) {
+                    state[i] = _mm512_xor_si512(state[i], _mm512_loadu_si512((const __m512i *) ref_block->v + i));
+                    block_XY[i] = _mm512_xor_si512(state[i], _mm512_loadu_si512((const __m512i *) next_block->v + i));
+                }
+            } else {
+                #pragma GCC unroll 16
+                for (uint32_t i = 0; i < ARGON2_ZWORDS_IN_BLOCK; ++i) {
+                    block_XY[i] = state[i] = _mm512_xor_si512(
+                            state[i], _mm512_loadu_si512((const __m512i *) ref_block->v + i));
+                }
+            }
+
+            /**
+             * Row k occupies state[2 * k] (v0..v7) and state[2 * k + 1] (v8..v15).
+             * Each call processes four rows, two of them per 256-bit half.
+             */
+            #pragma GCC unroll 2
+            for (uint32_t i = 0; i < 2; ++i) {
+                BLAMKA_ROUND_ROWS_AVX512(
+                        state[8 * i + 0], state[8 * i + 1], state[8 * i + 2], state[8 * i + 3],
+                        state[8 * i + 4], state[8 * i + 5], state[8 * i + 6], state[8 * i + 7]
+                );
+            }
+
+            /**
+             * i = 0 processes columns 0..3 (low halves of the rows),
+             * i = 1 processes columns 4..7 (high halves of the rows)
+             */
+            #pragma GCC unroll 2
+            for (uint32_t i = 0; i < 2; ++i) {
+                BLAMKA_ROUND_COLUMNS_AVX512(
+                        state[ 0 + i], state[ 2 + i], state[ 4 + i], state[ 6 + i],
+                        state[ 8 + i], state[10 + i], state[12 + i], state[14 + i]
+                );
+
+                /* state[0] is final after the first columns, report the first word before the rest is done */
+                if (i == 0)
+                    first_word((uint64_t)_mm_cvtsi128_si64(_mm512_castsi512_si128(_mm512_xor_si512(state[0], block_XY[0]))));
+            }
+
+            #pragma GCC unroll 16
+            for (uint32_t i = 0; i < ARGON2_ZWORDS_IN_BLOCK; ++i) {
+                state[i] = _mm512_xor_si512(state[i], block_XY[i]);
+                _mm512_storeu_si512((__m512i *) next_block->v + i, state[i]);
+            }
+        }
+
+        /* 128 gathers per block make batched Argon2d slower than hashing one password at a time */
+        uint32_t batch_width__() const {
+            return atype == Argon2Type::Argon2_d ? 1 : 8;
+        }
+
+        void fill_block_batch__(const uint64_t *prev_block, const uint64_t *ref_block,
+                                uint64_t *next_block, bool with_xor) const {
+            const __m512i* prev = (const __m512i*)prev_block;
+            const __m512i* ref = (const __m512i*)ref_block;
+            __m512i* next = (__m512i*)next_block;
+            __m512i block_XY[ARGON2_QWORDS_IN_BLOCK];
+            __m512i state[ARGON2_QWORDS_IN_BLOCK];
+
+            for (uint32_t i = 0; i < ARGON2_QWORDS_IN_BLOCK; ++i) {
+                state[i] = _mm512_xor_si512(_mm512_loadu_si512(prev + i), _mm512_loadu_si512(ref + i));
+                block_XY[i] = with_xor ? _mm512_xor_si512(state[i], _mm512_loadu_si512(next + i)) : state[i];
+            }
+
+            /* the same permutation as in the reference version but every qword is a register */
+            for (uint32_t i = 0; i < 8; ++i) {
+                BLAMKA_ROUND_BATCH_AVX512(
+                        state[16 * i +  0], state[16 * i +  1], state[16 * i +  2], state[16 * i +  3],
+                        state[16 * i +  4], state[16 * i +  5], state[16 * i +  6], state[16 * i +  7],
+                        state[16 * i +  8], state[16 * i +  9], state[16 * i + 10], state[16 * i + 11],
+                        state[16 * i + 12], state[16 * i + 13], state[16 * i + 14], state[16 * i + 15]);
+            }
+
+            for (uint32_t i = 0; i < 8; ++i) {
+                BLAMKA_ROUND_BATCH_AVX512(
+                        state[2 * i +  0], state[2 * i +  1], state[2 * i +  16], state[2 * i +  17],
+                        state[2 * i + 32], state[2 * i + 33], state[2 * i +  48], state[2 * i +  49],
+                        state[2 * i + 64], state[2 * i + 65], state[2 * i +  80], state[2 * i +  81],
+                        state[2 * i + 96], state[2 * i + 97], state[2 * i + 112], state[2 * i + 113]);
+            }
+
+            for (uint32_t i = 0; i < ARGON2_QWORDS_IN_BLOCK; ++i)
+                _mm512_storeu_si512(next + i, _mm512_xor_si512(state[i], block_XY[i]));
+        }
+
+        void fill_block_batch_gather__(const uint64_t *prev_block, const uint64_t *memory, const uint64_t *ref_offsets,
+                                       uint64_t *next_block, bool with_xor) const {
+            __m512i ref_block[ARGON2_QWORDS_IN_BLOCK];
+            const __m512i offsets = _mm512_loadu_si512((const __m512i*)ref_offsets);
+
+            for (uint32_t i = 0; i < ARGON2_QWORDS_IN_BLOCK; ++i)
+                ref_block[i] = _mm512_i64gather_epi64(offsets, (const void*)(memory + 8 * i), 8);
+
+            fill_block_batch__(prev_block, (const uint64_t*)ref_block, next_block, with_xor);
+        }
+    };
+}
@@ -5,9 +5,18 @@
 #include <new>
 #include <cstdlib>
 #include <memory>
+#include <algorithm>
+#include <type_traits>
+#include <vector>
+#include <mutex>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 #include "argonishche.h"
 #include "internal/blake2b/blake2b.h"
+#include "internal/blake2b/blake2b_multi.h"
 
 namespace argonishche {
     const uint32_t ARGON2_PREHASH_DIGEST_LENGTH = 64;
@@ -17,89 +26,43 @@ namespace argonishche {
     const uint32_t ARGON2_QWORDS_IN_BLOCK = ARGON2_BLOCK_SIZE / 8;
     const uint32_t ARGON2_OWORDS_IN_BLOCK = ARGON2_BLOCK_SIZE / 16;
     const uint32_t ARGON2_HWORDS_IN_BLOCK = ARGON2_BLOCK_SIZE / 32;
+    const uint32_t ARGON2_ZWORDS_IN_BLOCK = ARGON2_BLOCK_SIZE / 64;
     const uint32_t ARGON2_ADDRESSES_IN_BLOCK = 128;
     const uint32_t ARGON2_SYNC_POINTS = 4;
     const uint32_t ARGON2_SALT_MIN_LEN = 8;
     const uint32_t ARGON2_MIN_OUTLEN = 4;
+    const uint32_t ARGON2_MAX_BATCH_WIDTH = 8;
+
+#ifndef ARGONISHCHE_PREFETCH_DISTANCE
+#define ARGONISHCHE_PREFETCH_DISTANCE 8
+#endif
+    /* How many blocks ahead data-independent addressing prefetches the reference blocks, 0 turns it off */
+    const uint32_t ARGON2_PREFETCH_DISTANCE = ARGONISHCHE_PREFETCH_DISTANCE;
+
+#ifndef ARGONISHCHE_REFERENCE_TABLE_LIMIT
+#define ARGONISHCHE_REFERENCE_TABLE_LIMIT 16777216
+#endif
+    /* The largest table of data-independent reference positions an instance keeps, in bytes. 0 turns the tables off */
+    const size_t ARGON2_REFERENCE_TABLE_LIMIT = ARGONISHCHE_REFERENCE_TABLE_LIMIT;
 
     struct block {
         uint64_t v[ARGON2_QWORDS_IN_BLOCK];
     };
 
-    template <InstructionSet instructionSet, uint32_t mcost, uint32_t threads>
-    class Argon2 : public Argon2Base {
-    public:
-        Argon2(Argon2Type atype, uint32_t tcost, const uint8_t *key, uint32_t keylen)
-                : secretlen__(keylen), tcost__(tcost), atype__(atype) {
-
-            if(secretlen__)
-                memcpy(secret__, key, keylen);
-        }
-
-        virtual ~Argon2() override {
-            if (secretlen__) {
-                secure_zero_memory__(secret__, secretlen__);
-                secretlen__ = 0;
-            }
-        }
-
-        virtual void Hash(const uint8_t *pwd, uint32_t pwdlen, const uint8_t *salt, uint32_t saltlen,
-                  uint8_t *out, uint32_t outlen, const uint8_t *aad = nullptr, uint32_t aadlen = 0) const override {
-
-            std::unique_ptr<block[]> buffer(new block[memory_blocks__]);
-            internal_hash__(buffer.get(), pwd, pwdlen, salt, saltlen, out, outlen, aad, aadlen);
-        }
-
-        virtual bool Verify(const uint8_t *pwd, uint32_t pwdlen, const uint8_t *salt, uint32_t saltlen,
-                    const uint8_t *hash, uint32_t hashlen, const uint8_t *aad = nullptr, uint32_t aadlen = 0) const override {
-            std::unique_ptr<uint8_t[]> hash_result(new uint8_t[hashlen]);
-            Hash(pwd, pwdlen, salt, saltlen, hash_result.get(), hashlen, aad, aadlen);
-
-            return secure_compare__(hash, hash_result.get(), hashlen);
-        }
-
-        virtual void HashWithCustomMemory(uint8_t* memory, size_t mlen, const uint8_t *pwd, uint32_t pwdlen,
-                                          const uint8_t* salt, uint32_t saltlen, uint8_t* out, uint32_t outlen,
-                                          const uint8_t* aad = nullptr, uint32_t aadlen = 0) const override {
-            if(memory == nullptr || mlen < sizeof(block) * memory_blocks__)
-                throw std::runtime_error("memory is null or its size is not enough");
-
-            internal_hash__((block*)memory, pwd, pwdlen, salt, saltlen, out, outlen, aad, aadlen);
-        }
-
-        virtual bool VerifyWithCustomMemory(uint8_t* memory, size_t mlen, const uint8_t *pwd, uint32_t pwdlen,
-                                            const uint8_t *salt, uint32_t saltlen, const uint8_t *hash, uint32_t hashlen,
-                                            const uint8_t *aad = nullptr, uint32_t aadlen = 0) const override {
-            std::unique_ptr<uint8_t[]> hash_result(new uint8_t[hashlen]);
-            HashWithCustomMemory(memory, mlen, pwd, pwdlen, salt, saltlen, hash_result.get(), hashlen, aad, aadlen);
-
-            return secure_compare__(hash_result.get(), hash, hashlen);
-        }
-
-        virtual size_t GetMemorySize() const override {
-            return memory_blocks__ * sizeof(block);
-        }
-
-    protected: /* Constants */
-        uint8_t secret__[ARGON2_SECRET_MAX_LENGTH] = {0};
-        uint32_t secretlen__ = 0;
-        uint32_t tcost__;
-        Argon2Type atype__;
-
-        static constexpr uint32_t lanes__ = threads;
-        static constexpr uint32_t memory_blocks__ = (mcost >= 2 * ARGON2_SYNC_POINTS * lanes__) ?
-                                                    (mcost - mcost % (lanes__ * ARGON2_SYNC_POINTS)) :
-                                                    2 * ARGON2_SYNC_POINTS * lanes__;
-        static constexpr uint32_t segment_length__ = memory_blocks__ / (lanes__ * ARGON2_SYNC_POINTS);
-        static constexpr uint32_t lane_length__ = segment_length__ * ARGON2_SYNC_POINTS;
-
-    protected: /* Prototypes */
-        virtual void fill_block__(const block *prev_block, const block *ref_block,
-                        block *next_block, bool with_xor) const = 0;
-
-        virtual void copy_block__(block *dst, const block *src) const = 0;
-        virtual void xor_block__(block *dst, const block *src) const = 0;
+    /**
+     * Default callback of fill_block__ kernels. The kernels pass the first word of the new block
+     * to the callback as soon as it is computed, before the block is stored
+     */
+    struct Argon2IgnoreFirstWord {
+        void operator()(uint64_t) const { }
+    };
 
+    /**
+     * Functions that only depend on the instruction set and the number of lanes.
+     * All the Argon2 instances share them instead of compiling their own copies
+     */
+    template <InstructionSet instructionSet>
+    class Argon2Common {
     protected: /* Static functions */
         static bool secure_compare__(const uint8_t* buffer1, const uint8_t* buffer2, uint32_t len) {
             bool result = true;
@@ -119,9 +82,7 @@ namespace argonishche {
         }
 
         static void blake2b_hash64__(uint8_t out[BLAKE2B_OUTBYTES], const uint8_t in[BLAKE2B_OUTBYTES]) {
-            Blake2B<instructionSet> hash(BLAKE2B_OUTBYTES);
-            hash.Update(in, BLAKE2B_OUTBYTES);
-            hash.Final(out, BLAKE2B_OUTBYTES);
+            Blake2B<instructionSet>::Hash64(out, in);
         }
 
         static void argon2_expand_blockhash__(uint8_t expanded[ARGON2_BLOCK_SIZE],
@@ -169,9 +130,7 @@ namespace argonishche {
 
                 while(toproduce > BLAKE2B_OUTBYTES) {
                     memcpy(in_buffer, out_buffer, BLAKE2B_OUTBYTES);
-                    Blake2B<instructionSet> hash(BLAKE2B_OUTBYTES);
-                    hash.Update(in_buffer, BLAKE2B_OUTBYTES);
-                    hash.Final(out_buffer, BLAKE2B_OUTBYTES);
+                    blake2b_hash64__(out_buffer, in_buffer);
                     memcpy(out, out_buffer, BLAKE2B_OUTBYTES / 2);
                     out += BLAKE2B_OUTBYTES / 2;
                     toproduce -= BLAKE2B_OUTBYTES / 2;
@@ -191,6 +150,259 @@ namespace argonishche {
             memset(b->v, in, sizeof(b->v));
         }
 
+        /* The first two blocks of lane l are written to blocks[l * stride] and blocks[l * stride + 1] */
+        template <uint32_t lanes>
+        static void fill_first_blocks__(block* blocks, uint8_t *blockhash, uint32_t stride) {
+            fill_first_blocks__<lanes>(blocks, blockhash, stride, Blake2BMultiVectorized<instructionSet>());
+        }
+
+        /**
+         * The first two blocks of every lane are independent Blake2B chains,
+         * so they are expanded at once with multi-buffer Blake2B, one chain per SIMD lane
+         */
+        template <uint32_t lanes>
+        static void fill_first_blocks__(block* blocks, uint8_t *blockhash, uint32_t stride, std::true_type) {
+            const uint32_t HALF_OUT_BYTES = BLAKE2B_OUTBYTES / 2;
+            const uint32_t HASH_BLOCKS_COUNT = ARGON2_BLOCK_SIZE / HALF_OUT_BYTES;
+            const uint32_t CHAINS = 2 * lanes;
+            const uint32_t SEED_LENGTH = sizeof(uint32_t) + ARGON2_PREHASH_SEED_LENGTH;
+
+            uint8_t seeds[CHAINS][SEED_LENGTH];
+            uint8_t chain[2][CHAINS][BLAKE2B_OUTBYTES];
+            const uint8_t* in[CHAINS];
+            uint8_t* out[CHAINS];
+            size_t inlen[CHAINS];
+            uint8_t* expanded[CHAINS];
+
+            for (uint32_t c = 0; c < CHAINS; ++c) {
+                /* lane c / 2, block c % 2 */
+                store32__(ARGON2_BLOCK_SIZE, seeds[c]);
+                memcpy(seeds[c] + sizeof(uint32_t), blockhash, ARGON2_PREHASH_DIGEST_LENGTH);
+                store32__(c % 2, seeds[c] + sizeof(uint32_t) + ARGON2_PREHASH_DIGEST_LENGTH);
+                store32__(c / 2, seeds[c] + sizeof(uint32_t) + ARGON2_PREHASH_DIGEST_LENGTH + 4);
+                expanded[c] = (uint8_t*)&(blocks[(c / 2) * stride + c % 2]);
+
+                in[c] = seeds[c];
+                inlen[c] = SEED_LENGTH;
+                out[c] = chain[0][c];
+            }
+
+            Blake2BMulti<instructionSet> hash(BLAKE2B_OUTBYTES);
+            hash.Hash(in, inlen, out, CHAINS);
+
+            for (uint32_t i = 1; i < HASH_BLOCKS_COUNT - 1; ++i) {
+                for (uint32_t c = 0; c < CHAINS; ++c) {
+                    memcpy(expanded[c] + (i - 1) * HALF_OUT_BYTES, chain[(i - 1) % 2][c], HALF_OUT_BYTES);
+                    in[c] = chain[(i - 1) % 2][c];
+                    inlen[c] = BLAKE2B_OUTBYTES;
+                    out[c] = chain[i % 2][c];
+                }
+                hash.Hash(in, inlen, out, CHAINS);
+            }
+
+            for (uint32_t c = 0; c < CHAINS; ++c)
+                memcpy(expanded[c] + HALF_OUT_BYTES * (HASH_BLOCKS_COUNT - 2), chain[(HASH_BLOCKS_COUNT - 2) % 2][c], BLAKE2B_OUTBYTES);
+
+            secure_zero_memory__(seeds, sizeof(seeds));
+            secure_zero_memory__(chain, sizeof(chain));
+        }
+
+        template <uint32_t lanes>
+        static void fill_first_blocks__(block* blocks, uint8_t *blockhash, uint32_t stride, std::false_type) {
+            for (uint32_t l = 0; l < lanes; l++) {
+                /* fill the first block of the lane */
+                store32__(l, blockhash + ARGON2_PREHASH_DIGEST_LENGTH + 4);
+                store32__(0, blockhash + ARGON2_PREHASH_DIGEST_LENGTH);
+                argon2_expand_blockhash__((uint8_t*)&(blocks[l * stride]), blockhash);
+
+                /* fill the second block of the lane */
+                store32__(1, blockhash + ARGON2_PREHASH_DIGEST_LENGTH);
+                argon2_expand_blockhash__((uint8_t*)&(blocks[l * stride + 1]), blockhash);
+            }
+        }
+    };
+
+    /**
+     * Derived is the final class implementing the block functions (CRTP).
+     * The kernels are called without virtual dispatch, so they get inlined into the segment loops.
+     * The type is a template parameter as well, so every type gets its own segment loop
+     */
+    template <class Derived, InstructionSet instructionSet, Argon2Type atype, uint32_t mcost, uint32_t threads>
+    class Argon2 : public Argon2Base, protected Argon2Common<instructionSet> {
+        using Common = Argon2Common<instructionSet>;
+        using Common::secure_compare__;
+        using Common::secure_zero_memory__;
+        using Common::blake2b_long__;
+        using Common::init_block_value__;
+
+    public:
+        Argon2(uint32_t tcost, const uint8_t *key, uint32_t keylen)
+                : secretlen__(keylen), tcost__(tcost) {
+
+            if(secretlen__)
+                memcpy(secret__, key, keylen);
+        }
+
+        virtual ~Argon2() override {
+            if (secretlen__) {
+                secure_zero_memory__(secret__, secretlen__);
+                secretlen__ = 0;
+            }
+        }
+
+        virtual void Hash(const uint8_t *pwd, uint32_t pwdlen, const uint8_t *salt, uint32_t saltlen,
+                  uint8_t *out, uint32_t outlen, const uint8_t *aad = nullptr, uint32_t aadlen = 0) const override {
+
+            std::unique_ptr<block[]> buffer(new block[memory_blocks__]);
+            internal_hash__(buffer.get(), pwd, pwdlen, salt, saltlen, out, outlen, aad, aadlen);
+        }
+
+        virtual bool Verify(const uint8_t *pwd, uint32_t pwdlen, const uint8_t *salt, uint32_t saltlen,
+                    const uint8_t *hash, uint32_t hashlen, const uint8_t *aad = nullptr, uint32_t aadlen = 0) const override {
+            std::unique_ptr<uint8_t[]> hash_result(new uint8_t[hashlen]);
+            Hash(pwd, pwdlen, salt, saltlen, hash_result.get(), hashlen, aad, aadlen);
+
+            return secure_compare__(hash, hash_result.get(), hashlen);
+        }
+
+        virtual void HashWithCustomMemory(uint8_t* memory, size_t mlen, const uint8_t *pwd, uint32_t pwdlen,
+                                          const uint8_t* salt, uint32_t saltlen, uint8_t* out, uint32_t outlen,
+                                          const uint8_t* aad = nullptr, uint32_t aadlen = 0) const override {
+            if(memory == nullptr || mlen < sizeof(block) * memory_blocks__)
+                throw std::runtime_error("memory is null or its size is not enough");
+
+            internal_hash__((block*)memory, pwd, pwdlen, salt, saltlen, out, outlen, aad, aadlen);
+        }
+
+        virtual bool VerifyWithCustomMemory(uint8_t* memory, size_t mlen, const uint8_t *pwd, uint32_t pwdlen,
+                                            const uint8_t *salt, uint32_t saltlen, const uint8_t *hash, uint32_t hashlen,
+                                            const uint8_t *aad = nullptr, uint32_t aadlen = 0) const override {
+            std::unique_ptr<uint8_t[]> hash_result(new uint8_t[hashlen]);
+            HashWithCustomMemory(memory, mlen, pwd, pwdlen, salt, saltlen, hash_result.get(), hashlen, aad, aadlen);
+
+            return secure_compare__(hash_result.get(), hash, hashlen);
+        }
+
+        virtual size_t GetMemorySize() const override {
+            return memory_blocks__ * sizeof(block);
+        }
+
+        virtual void HashBatch(const uint8_t* const* pwd, const uint32_t* pwdlen,
+                               const uint8_t* const* salt, const uint32_t* saltlen,
+                               uint8_t* const* out, uint32_t outlen, size_t count,
+                               const uint8_t* aad = nullptr, uint32_t aadlen = 0) const override {
+            const uint32_t width = derived__().batch_width__();
+            if (width == 1) {
+                for (size_t i = 0; i < count; ++i)
+                    Hash(pwd[i], pwdlen[i], salt[i], saltlen[i], out[i], outlen, aad, aadlen);
+                return;
+            }
+
+            std::unique_ptr<uint64_t[]> buffer(new uint64_t[(size_t)memory_blocks__ * ARGON2_QWORDS_IN_BLOCK * width]);
+            for (size_t first = 0; first < count; first += width) {
+                internal_hash_batch__(buffer.get(), pwd + first, pwdlen + first, salt + first, saltlen + first,
+                                      out + first, outlen, std::min<size_t>(width, count - first), aad, aadlen);
+            }
+        }
+
+        virtual void VerifyBatch(const uint8_t* const* pwd, const uint32_t* pwdlen,
+                                 const uint8_t* const* salt, const uint32_t* saltlen,
+                                 const uint8_t* const* hash, uint32_t hashlen, bool* result, size_t count,
+                                 const uint8_t* aad = nullptr, uint32_t aadlen = 0) const override {
+            std::unique_ptr<uint8_t[]> hash_results(new uint8_t[hashlen * count]);
+            std::unique_ptr<uint8_t*[]> out(new uint8_t*[count]);
+            for (size_t i = 0; i < count; ++i)
+                out[i] = hash_results.get() + hashlen * i;
+
+            HashBatch(pwd, pwdlen, salt, saltlen, out.get(), hashlen, count, aad, aadlen);
+
+            for (size_t i = 0; i < count; ++i)
+                result[i] = secure_compare__(hash[i], out[i], hashlen);
+        }
+
+        virtual uint32_t GetBatchSize() const override {
+            return derived__().batch_width__();
+        }
+
+    protected: /* Constants */
+        uint8_t secret__[ARGON2_SECRET_MAX_LENGTH] = {0};
+        uint32_t secretlen__ = 0;
+        uint32_t tcost__;
+
+        /*
+         * Data-independent reference positions only depend on the parameters of the instance, so they are computed
+         * once on the first use and then only read, from any thread. Segment (pass, slice, lane) starts at
+         * ((pass * ARGON2_SYNC_POINTS + slice) * lanes__ + lane) * segment_length__
+         */
+        mutable std::vector<uint32_t> ref_table__;
+        mutable std::once_flag ref_table_once__;
+
+        static constexpr Argon2Type atype__ = atype;
+
+        static constexpr uint32_t lanes__ = threads;
+        static constexpr uint32_t memory_blocks__ = (mcost >= 2 * ARGON2_SYNC_POINTS * lanes__) ?
+                                                    (mcost - mcost % (lanes__ * ARGON2_SYNC_POINTS)) :
+                                                    2 * ARGON2_SYNC_POINTS * lanes__;
+        static constexpr uint32_t segment_length__ = memory_blocks__ / (lanes__ * ARGON2_SYNC_POINTS);
+        static constexpr uint32_t lane_length__ = segment_length__ * ARGON2_SYNC_POINTS;
+
+    protected: /* Prototypes */
+        /*
+         * Derived classes implement
+         * template <class FirstWordCallback = Argon2IgnoreFirstWord>
+         * void fill_block__(const block *prev_block, const block *ref_block, block *next_block, bool with_xor,
+         *                   FirstWordCallback first_word = FirstWordCallback()) const;
+         * void copy_block__(block *dst, const block *src) const;
+         * void xor_block__(block *dst, const block *src) const;
+         * A kernel may also hide fill_blocks__ to keep the previous block in registers
+         */
+        const Derived& derived__() const {
+            return static_cast<const Derived&>(*this);
+        }
+
+        /**
+         * Fills count consecutive blocks starting at next_block. The first of them follows prev_block,
+         * every other one follows the block before it. ref_block(k, pseudo_rand) returns the reference block
+         * of next_block[k], pseudo_rand being the first word of the block before it; for k > 0 it is called
+         * from the kernel as soon as that word is computed
+         */
+        template <class RefBlock>
+        void fill_blocks__(const block *prev_block, block *next_block, uint32_t count, bool with_xor,
+                           RefBlock ref_block) const {
+            const block* ref = ref_block(0, prev_block->v[0]);
+
+            for (uint32_t k = 0; k < count; ++k) {
+                const block* next_ref = nullptr;
+                derived__().fill_block__(k == 0 ? prev_block : next_block + k - 1, ref, next_block + k, with_xor,
+                                         [&](uint64_t pseudo_rand) {
+                    if (k + 1 < count)
+                        next_ref = ref_block(k + 1, pseudo_rand);
+                });
+                ref = next_ref;
+            }
+        }
+
+        /**
+         * Batch versions work with an interleaved memory of batch_width__() hashes:
+         * the k-th qword of the j-th block of hash h is memory[(j * ARGON2_QWORDS_IN_BLOCK + k) * width + h].
+         * The reference block is either shared by all the hashes (data-independent addressing)
+         * or given by per-hash qword offsets into the memory (data-dependent addressing).
+         * Derived classes supporting batches hide these functions
+         */
+        uint32_t batch_width__() const {
+            return 1;
+        }
+
+        void fill_block_batch__(const uint64_t *prev_block, const uint64_t *ref_block,
+                                uint64_t *next_block, bool with_xor) const {
+            throw std::logic_error("Batch processing is not supported");
+        }
+
+        void fill_block_batch_gather__(const uint64_t *prev_block, const uint64_t *memory, const uint64_t *ref_offsets,
+                                       uint64_t *next_block, bool with_xor) const {
+            throw std::logic_error("Batch processing is not supported");
+        }
+
     protected: /* Functions */
         void internal_hash__(block* memory, const uint8_t *pwd, uint32_t pwdlen,
                           const uint8_t *salt, uint32_t saltlen, uint8_t *out, uint32_t outlen,
@@ -239,23 +451,16 @@ namespace argonishche {
             hash.Final(blockhash, ARGON2_PREHASH_DIGEST_LENGTH);
         }
 
-        void fill_first_blocks__(block* blocks, uint8_t *blockhash) const {
-            for (uint32_t l = 0; l < lanes__; l++) {
-                /* fill the first block of the lane */
-                store32__(l, blockhash + ARGON2_PREHASH_DIGEST_LENGTH + 4);
-                store32__(0, blockhash + ARGON2_PREHASH_DIGEST_LENGTH);
-                argon2_expand_blockhash__((uint8_t*)&(blocks[l * lane_length__]), blockhash);
-
-                /* fill the second block of the lane */
-                store32__(1, blockhash + ARGON2_PREHASH_DIGEST_LENGTH);
-                argon2_expand_blockhash__((uint8_t*)&(blocks[l * lane_length__ + 1]), blockhash);
-            }
-        }
-
         /* The 'if' will be optimized out as the number of threads is known at the compile time */
         void fill_memory_blocks__(block* memory) const {
+            const bool interleave = lanes__ > 1 && single_threaded__();
+
             for (uint32_t t = 0; t < tcost__; ++t) {
                 for (uint32_t s = 0; s < ARGON2_SYNC_POINTS; ++s) {
+                    if (interleave) {
+                        fill_slice_interleaved__(memory, t, s);
+                        continue;
+                    }
 #ifdef _OPENMP
                     #pragma omp parallel for
 #endif
@@ -266,11 +471,230 @@ namespace argonishche {
             }
         }
 
+        /* Lanes can't be processed in parallel without OpenMP, with one OpenMP thread or from a parallel region */
+        static bool single_threaded__() {
+#ifdef _OPENMP
+            return omp_get_max_threads() == 1 || omp_in_parallel();
+#else
+            return true;
+#endif
+        }
+
+        static void prefetch_block__(const block* b) {
+            for (uint32_t i = 0; i < ARGON2_BLOCK_SIZE; i += 64)
+                __builtin_prefetch((const uint8_t*)b->v + i);
+        }
+
+        /**
+         * Fills a slice of all the lanes on a single core. The lanes advance in lockstep,
+         * so the reference blocks of all the lanes are known before any of the next blocks is computed.
+         * They are prefetched together and the memory latencies overlap instead of adding up
+         */
+        void fill_slice_interleaved__(block *memory, uint32_t pass, uint32_t slice) const {
+            const bool data_independent = atype__ == Argon2Type::Argon2_i ||
+                    (atype__ == Argon2Type::Argon2_id && pass == 0 && slice < ARGON2_SYNC_POINTS / 2);
+
+            const uint32_t* table = data_independent ? ref_table_segment__(pass, 0, slice) : nullptr;
+            const bool generate_addresses = data_independent && table == nullptr;
+
+            block address_blocks[lanes__], input_blocks[lanes__], zero_block;
+            const block* ref_blocks[lanes__];
+
+            if (generate_addresses) {
+                init_block_value__(&zero_block, 0);
+                for (uint32_t l = 0; l < lanes__; ++l) {
+                    init_block_value__(&input_blocks[l], 0);
+
+                    input_blocks[l].v[0] = pass;
+                    input_blocks[l].v[1] = l;
+                    input_blocks[l].v[2] = slice;
+                    input_blocks[l].v[3] = memory_blocks__;
+                    input_blocks[l].v[4] = tcost__;
+                    input_blocks[l].v[5] = (uint64_t)atype__;
+                }
+            }
+
+            uint32_t starting_index = 0;
+
+            if (pass == 0 && slice == 0) {
+                starting_index = 2;
+                if (generate_addresses) {
+                    for (uint32_t l = 0; l < lanes__; ++l)
+                        next_addresses(&address_blocks[l], &input_blocks[l], &zero_block);
+                }
+            }
+
+            for (uint32_t i = starting_index; i < segment_length__; ++i) {
+                const uint32_t index = slice * segment_length__ + i;
+
+                for (uint32_t l = 0; l < lanes__; ++l) {
+                    const uint32_t curr_offset = l * lane_length__ + index;
+                    const uint32_t prev_offset = (index == 0) ? curr_offset + lane_length__ - 1 : curr_offset - 1;
+
+                    /* Segments of the same slice follow each other in the table */
+                    if (table != nullptr) {
+                        ref_blocks[l] = memory + table[l * segment_length__ + i];
+                        prefetch_block__(ref_blocks[l]);
+                        continue;
+                    }
+
+                    uint64_t pseudo_rand;
+                    if (generate_addresses) {
+                        if (i % ARGON2_ADDRESSES_IN_BLOCK == 0)
+                            next_addresses(&address_blocks[l], &input_blocks[l], &zero_block);
+                        pseudo_rand = address_blocks[l].v[i % ARGON2_ADDRESSES_IN_BLOCK];
+                    } else {
+                        pseudo_rand = memory[prev_offset].v[0];
+                    }
+
+                    uint64_t ref_lane = (pass == 0 && slice == 0) ? l : (((pseudo_rand >> 32)) % lanes__);
+                    uint64_t ref_index = index_alpha__(pass, slice, i, (uint32_t)(pseudo_rand & 0xFFFFFFFF), ref_lane == l);
+
+                    ref_blocks[l] = memory + lane_length__ * ref_lane + ref_index;
+                    prefetch_block__(ref_blocks[l]);
+                }
+
+                for (uint32_t l = 0; l < lanes__; ++l) {
+                    const uint32_t curr_offset = l * lane_length__ + index;
+                    const uint32_t prev_offset = (index == 0) ? curr_offset + lane_length__ - 1 : curr_offset - 1;
+                    derived__().fill_block__(memory + prev_offset, ref_blocks[l], memory + curr_offset, pass != 0);
+                }
+            }
+        }
+
         void initialize__(block *memory, uint32_t outlen, const uint8_t *pwd, uint32_t pwdlen,
                           const uint8_t *salt, uint32_t saltlen, const uint8_t *aad, uint32_t aadlen) const {
             uint8_t blockhash[ARGON2_PREHASH_SEED_LENGTH];
             initial_hash__(blockhash, outlen, pwd, pwdlen, salt, saltlen, aad, aadlen);
-            fill_first_blocks__(memory, blockhash);
+            Common::template fill_first_blocks__<lanes__>(memory, blockhash, lane_length__);
+        }
+
+        void internal_hash_batch__(uint64_t* memory, const uint8_t* const* pwd, const uint32_t* pwdlen,
+                                   const uint8_t* const* salt, const uint32_t* saltlen,
+                                   uint8_t* const* out, uint32_t outlen, size_t n,
+                                   const uint8_t* aad, uint32_t aadlen) const {
+            /*
+             * all parameters checks are in proxy objects.
+             * If n is less than the batch width the first password fills up the unused lanes
+             */
+            const uint32_t width = derived__().batch_width__();
+            std::unique_ptr<block[]> first_blocks(new block[2 * lanes__]);
+
+            for (uint32_t h = 0; h < width; ++h) {
+                const size_t src = h < n ? h : 0;
+                uint8_t blockhash[ARGON2_PREHASH_SEED_LENGTH];
+                initial_hash__(blockhash, outlen, pwd[src], pwdlen[src], salt[src], saltlen[src], aad, aadlen);
+                Common::template fill_first_blocks__<lanes__>(first_blocks.get(), blockhash, 2);
+                secure_zero_memory__(blockhash, sizeof(blockhash));
+
+                for (uint32_t l = 0; l < lanes__; ++l) {
+                    for (uint32_t i = 0; i < 2; ++i) {
+                        uint64_t* dst = memory + (size_t)(l * lane_length__ + i) * ARGON2_QWORDS_IN_BLOCK * width;
+                        for (uint32_t k = 0; k < ARGON2_QWORDS_IN_BLOCK; ++k)
+                            dst[k * width + h] = first_blocks[2 * l + i].v[k];
+                    }
+                }
+            }
+            secure_zero_memory__(first_blocks.get(), sizeof(block) * 2 * lanes__);
+
+            for (uint32_t t = 0; t < tcost__; ++t) {
+                for (uint32_t s = 0; s < ARGON2_SYNC_POINTS; ++s) {
+#ifdef _OPENMP
+                    #pragma omp parallel for
+#endif
+                    for (uint32_t l = 0; l < lanes__; ++l) {
+                        fill_segment_batch__(memory, t, l, s);
+                    }
+                }
+            }
+
+            for (uint32_t h = 0; h < n; ++h) {
+                block blockhash;
+                init_block_value__(&blockhash, 0);
+                for (uint32_t l = 0; l < lanes__; ++l) {
+                    const uint64_t* last = memory + (size_t)(l * lane_length__ + lane_length__ - 1) * ARGON2_QWORDS_IN_BLOCK * width;
+                    for (uint32_t k = 0; k < ARGON2_QWORDS_IN_BLOCK; ++k)
+                        blockhash.v[k] ^= last[k * width + h];
+                }
+
+                blake2b_long__(out[h], outlen, (uint8_t*)blockhash.v, ARGON2_BLOCK_SIZE);
+                secure_zero_memory__(blockhash.v, sizeof(blockhash.v));
+            }
+        }
+
+        /**
+         * Mirrors fill_segment_i__ and fill_segment_d__ for the interleaved memory.
+         * Data-independent addresses are the same for all the hashes in a batch as they only depend on
+         * the parameters, so the reference block is shared; otherwise every hash gets its own reference block.
+         */
+        void fill_segment_batch__(uint64_t *memory, uint32_t pass, uint32_t lane, uint32_t slice) const {
+            const uint32_t width = derived__().batch_width__();
+            const size_t block_qwords = (size_t)ARGON2_QWORDS_IN_BLOCK * width;
+            const bool data_independent = atype__ == Argon2Type::Argon2_i ||
+                    (atype__ == Argon2Type::Argon2_id && pass == 0 && slice < ARGON2_SYNC_POINTS / 2);
+
+            const uint32_t* table = data_independent ? ref_table_segment__(pass, lane, slice) : nullptr;
+            const bool generate_addresses = data_independent && table == nullptr;
+
+            block address_block, input_block, zero_block;
+            uint64_t ref_offsets[ARGON2_MAX_BATCH_WIDTH];
+
+            if (generate_addresses) {
+                init_block_value__(&zero_block, 0);
+                init_block_value__(&input_block, 0);
+
+                input_block.v[0] = pass;
+                input_block.v[1] = lane;
+                input_block.v[2] = slice;
+                input_block.v[3] = memory_blocks__;
+                input_block.v[4] = tcost__;
+                input_block.v[5] = (uint64_t)atype__;
+            }
+
+            uint32_t starting_index = 0;
+
+            if (pass == 0 && slice == 0) {
+                starting_index = 2;
+                if (generate_addresses)
+                    next_addresses(&address_block, &input_block, &zero_block);
+            }
+
+            uint32_t curr_offset = lane * lane_length__ + slice * segment_length__ + starting_index;
+            uint32_t prev_offset = curr_offset + ((curr_offset % lane_length__ == 0) ? lane_length__ : 0) - 1;
+
+            for (uint32_t i = starting_index; i < segment_length__; ++i, ++curr_offset, ++prev_offset) {
+                if (curr_offset % lane_length__ == 1) {
+                    prev_offset = curr_offset - 1;
+                }
+
+                const uint64_t* prev_block = memory + prev_offset * block_qwords;
+                uint64_t* curr_block = memory + curr_offset * block_qwords;
+
+                if (table != nullptr) {
+                    const uint64_t* ref_block = memory + table[i] * block_qwords;
+                    derived__().fill_block_batch__(prev_block, ref_block, curr_block, pass != 0);
+                } else if (data_independent) {
+                    if (i % ARGON2_ADDRESSES_IN_BLOCK == 0) {
+                        next_addresses(&address_block, &input_block, &zero_block);
+                    }
+
+                    uint64_t pseudo_rand = address_block.v[i % ARGON2_ADDRESSES_IN_BLOCK];
+                    uint64_t ref_lane = (pass == 0 && slice == 0) ? lane : (((pseudo_rand >> 32)) % lanes__);
+                    uint64_t ref_index = index_alpha__(pass, slice, i, (uint32_t)(pseudo_rand & 0xFFFFFFFF), ref_lane == lane);
+
+                    const uint64_t* ref_block = memory + (lane_length__ * ref_lane + ref_index) * block_qwords;
+                    derived__().fill_block_batch__(prev_block, ref_block, curr_block, pass != 0);
+                } else {
+                    for (uint32_t h = 0; h < width; ++h) {
+                        uint64_t pseudo_rand = prev_block[h];
+                        uint64_t ref_lane = (pass == 0 && slice == 0) ? lane : (((pseudo_rand >> 32)) % lanes__);
+                        uint64_t ref_index = index_alpha__(pass, slice, i, (uint32_t)(pseudo_rand & 0xFFFFFFFF), ref_lane == lane);
+                        ref_offsets[h] = (lane_length__ * ref_lane + ref_index) * block_qwords + h;
+                    }
+
+                    derived__().fill_block_batch_gather__(prev_block, memory, ref_offsets, curr_block, pass != 0);
+                }
+            }
         }
 
         uint32_t compute_reference_area__(uint32_t pass, uint32_t slice, uint32_t index, bool same_lane) const {
@@ -292,41 +716,107 @@ namespace argonishche {
             return (uint32_t)((start_position + relative_position) % lane_length__);
         }
 
+        uint32_t reference_position__(uint32_t pass, uint32_t lane, uint32_t slice, uint32_t index, uint64_t pseudo_rand) const {
+            uint64_t ref_lane = (pass == 0 && slice == 0) ? lane : (((pseudo_rand >> 32)) % lanes__);
+            uint64_t ref_index = index_alpha__(pass, slice, index, (uint32_t)(pseudo_rand & 0xFFFFFFFF), ref_lane == lane);
+
+            return (uint32_t)(lane_length__ * ref_lane + ref_index);
+        }
+
+        const block* reference_block__(const block *memory, uint32_t pass, uint32_t lane, uint32_t slice,
+                                       uint32_t index, uint64_t pseudo_rand) const {
+            return memory + reference_position__(pass, lane, slice, index, pseudo_rand);
+        }
+
+        /* Returns the reference positions of a data-independent segment or nullptr if they don't fit the limit */
+        const uint32_t* ref_table_segment__(uint32_t pass, uint32_t lane, uint32_t slice) const {
+            std::call_once(ref_table_once__, [this] { build_ref_table__(); });
+            if (ref_table__.empty())
+                return nullptr;
+
+            return ref_table__.data() + ((size_t)(pass * ARGON2_SYNC_POINTS + slice) * lanes__ + lane) * segment_length__;
+        }
+
+        void build_ref_table__() const {
+            const uint32_t slices = atype__ == Argon2Type::Argon2_i ? tcost__ * ARGON2_SYNC_POINTS :
+                                    atype__ == Argon2Type::Argon2_id ? ARGON2_SYNC_POINTS / 2 : 0;
+            const size_t size = (size_t)slices * lanes__ * segment_length__;
+            if (size == 0 || size * sizeof(uint32_t) > ARGON2_REFERENCE_TABLE_LIMIT)
+                return;
+
+            ref_table__.resize(size);
+
+            block address_block, input_block, zero_block;
+            init_block_value__(&zero_block, 0);
+
+            for (uint32_t s = 0; s < slices; ++s) {
+                const uint32_t pass = s / ARGON2_SYNC_POINTS;
+                const uint32_t slice = s % ARGON2_SYNC_POINTS;
+                const uint32_t starting_index = (pass == 0 && slice == 0) ? 2 : 0;
+
+                for (uint32_t l = 0; l < lanes__; ++l) {
+                    uint32_t* table = ref_table__.data() + ((size_t)s * lanes__ + l) * segment_length__;
+                    init_block_value__(&input_block, 0);
+
+                    input_block.v[0] = pass;
+                    input_block.v[1] = l;
+                    input_block.v[2] = slice;
+                    input_block.v[3] = memory_blocks__;
+                    input_block.v[4] = tcost__;
+                    input_block.v[5] = (uint64_t)atype__;
+
+                    /* The first two blocks are not computed but they still consume the first address block */
+                    for (uint32_t i = 0; i < segment_length__; ++i) {
+                        if (i % ARGON2_ADDRESSES_IN_BLOCK == 0)
+                            next_addresses(&address_block, &input_block, &zero_block);
+
+                        table[i] = i < starting_index ? 0 :
+                                   reference_position__(pass, l, slice, i, address_block.v[i % ARGON2_ADDRESSES_IN_BLOCK]);
+                    }
+                }
+            }
+        }
+
         void next_addresses(block *address_block, block *input_block, const block *zero_block) const {
             input_block->v[6]++;
-            fill_block__(zero_block, input_block, address_block, false);
-            fill_block__(zero_block, address_block, address_block, false);
+            derived__().fill_block__(zero_block, input_block, address_block, false);
+            derived__().fill_block__(zero_block, address_block, address_block, false);
         }
 
         void finalize__(const block* memory, uint8_t* out, uint32_t outlen) const {
             block blockhash;
-            copy_block__(&blockhash, memory + lane_length__ - 1);
+            derived__().copy_block__(&blockhash, memory + lane_length__ - 1);
 
             /* XOR the last blocks */
             for (uint32_t l = 1; l < lanes__; ++l) {
                 uint32_t last_block_in_lane = l * lane_length__ + (lane_length__ - 1);
-                xor_block__(&blockhash, memory + last_block_in_lane);
+                derived__().xor_block__(&blockhash, memory + last_block_in_lane);
             }
 
             blake2b_long__(out, outlen, (uint8_t*)blockhash.v, ARGON2_BLOCK_SIZE);
         }
 
-        /* The switch will be optimized out by the compiler as the type is known at the compile time */
         void fill_segment__(block *memory, uint32_t pass, uint32_t lane, uint32_t slice) const {
-            switch (atype__) {
-                case Argon2Type::Argon2_d:
-                    fill_segment_d__(memory, pass, lane, slice);
-                    return;
-                case Argon2Type::Argon2_i:
-                    fill_segment_i__(memory, pass, lane, slice, Argon2Type::Argon2_i);
-                    return;
-                case Argon2Type::Argon2_id:
-                    if(pass == 0 && slice < ARGON2_SYNC_POINTS / 2)
-                        fill_segment_i__(memory, pass, lane, slice, Argon2Type::Argon2_id);
-                    else
-                        fill_segment_d__(memory, pass, lane, slice);
-                    return;
-            }
+            fill_segment__(memory, pass, lane, slice, std::integral_constant<Argon2Type, atype__>());
+        }
+
+        /* Only the segment loops of the given type get instantiated */
+        void fill_segment__(block *memory, uint32_t pass, uint32_t lane, uint32_t slice,
+                            std::integral_constant<Argon2Type, Argon2Type::Argon2_d>) const {
+            fill_segment_d__(memory, pass, lane, slice);
+        }
+
+        void fill_segment__(block *memory, uint32_t pass, uint32_t lane, uint32_t slice,
+                            std::integral_constant<Argon2Type, Argon2Type::Argon2_i>) const {
+            fill_segment_i__(memory, pass, lane, slice);
+        }
+
+        void fill_segment__(block *memory, uint32_t pass, uint32_t lane, uint32_t slice,
+                            std::integral_constant<Argon2Type, Argon2Type::Argon2_id>) const {
+            if (pass == 0 && slice < ARGON2_SYNC_POINTS / 2)
+                fill_segment_i__(memory, pass, lane, slice);
+            else
+                fill_segment_d__(memory, pass, lane, slice);
         }
 
         void fill_segment_d__(block *memory, uint32_t pass, uint32_t lane, uint32_t slice) const {
@@ -334,21 +824,25 @@ namespace argonishche {
             uint32_t curr_offset = lane * lane_length__ + slice * segment_length__ + starting_index;
             uint32_t prev_offset = curr_offset + ((curr_offset % lane_length__ == 0) ? lane_length__ : 0) - 1;
 
-            for (uint32_t i = starting_index; i < segment_length__; ++i, ++curr_offset, ++prev_offset) {
-                if (curr_offset % lane_length__ == 1) {
-                    prev_offset = curr_offset - 1;
-                }
-
-                uint64_t pseudo_rand = memory[prev_offset].v[0];
-                uint64_t ref_lane = (pass == 0 && slice == 0) ? lane : (((pseudo_rand >> 32)) % lanes__);
-                uint64_t ref_index = index_alpha__(pass, slice, i, (uint32_t)(pseudo_rand & 0xFFFFFFFF), ref_lane == lane);
+            /*
+             * The first word of a new block selects the next reference block. The kernel reports it
+             * before the block is done, so the next reference block is fetched while the kernel finishes
+             */
+            derived__().fill_blocks__(memory + prev_offset, memory + curr_offset, segment_length__ - starting_index,
+                                      pass != 0, [&](uint32_t k, uint64_t pseudo_rand) {
+                const block* ref_block = reference_block__(memory, pass, lane, slice, starting_index + k, pseudo_rand);
+                prefetch_block__(ref_block);
+                return ref_block;
+            });
+        }
 
-                block* ref_block = memory + lane_length__ * ref_lane + ref_index;
-                fill_block__(memory + prev_offset, ref_block, memory + curr_offset, pass != 0);
+        void fill_segment_i__(block *memory, uint32_t pass, uint32_t lane, uint32_t slice) const {
+            const uint32_t* table = ref_table_segment__(pass, lane, slice);
+            if (table != nullptr) {
+                fill_segment_i_table__(memory, pass, lane, slice, table);
+                return;
             }
-        }
 
-        void fill_segment_i__(block *memory, uint32_t pass, uint32_t lane, uint32_t slice, Argon2Type atp) const {
             block address_block, input_block, zero_block;
             init_block_value__(&zero_block, 0);
             init_block_value__(&input_block, 0);
@@ -358,7 +852,7 @@ namespace argonishche {
             input_block.v[2] = slice;
             input_block.v[3] = memory_blocks__;
             input_block.v[4] = tcost__;
-            input_block.v[5] = (uint64_t)atp;
+            input_block.v[5] = (uint64_t)atype__;
 
             uint32_t starting_index = 0;
 
@@ -370,6 +864,9 @@ namespace argonishche {
             uint32_t curr_offset = lane * lane_length__ + slice * segment_length__ + starting_index;
             uint32_t prev_offset = curr_offset + ((curr_offset % lane_length__ == 0) ? lane_length__ : 0) - 1;
 
+            /* Reference blocks of the blocks below this index are already prefetched */
+            uint32_t prefetched = starting_index;
+
             for (uint32_t i = starting_index; i < segment_length__; ++i, ++curr_offset, ++prev_offset) {
                 if (curr_offset % lane_length__ == 1) {
                     prev_offset = curr_offset - 1;
@@ -379,13 +876,35 @@ namespace argonishche {
                     next_addresses(&address_block, &input_block, &zero_block);
                 }
 
-                uint64_t pseudo_rand = address_block.v[i % ARGON2_ADDRESSES_IN_BLOCK];
-                uint64_t ref_lane = (pass == 0 && slice == 0)? lane : (((pseudo_rand >> 32)) % lanes__);
-                uint64_t ref_index = index_alpha__(pass, slice, i, (uint32_t)(pseudo_rand & 0xFFFFFFFF), ref_lane == lane);
+                /* Addresses are only known up to the end of the current address block */
+                const uint32_t known = i - i % ARGON2_ADDRESSES_IN_BLOCK + ARGON2_ADDRESSES_IN_BLOCK;
+                const uint32_t ahead = std::min(i + 1 + ARGON2_PREFETCH_DISTANCE,
+                                                known < segment_length__ ? known : segment_length__);
+                for (prefetched = std::max(prefetched, i + 1); prefetched < ahead; ++prefetched) {
+                    prefetch_block__(reference_block__(memory, pass, lane, slice, prefetched,
+                                                       address_block.v[prefetched % ARGON2_ADDRESSES_IN_BLOCK]));
+                }
 
-                block* ref_block = memory + lane_length__ * ref_lane + ref_index;
-                fill_block__(memory + prev_offset, ref_block, memory + curr_offset, pass != 0);
+                const block* ref_block = reference_block__(memory, pass, lane, slice, i,
+                                                           address_block.v[i % ARGON2_ADDRESSES_IN_BLOCK]);
+                derived__().fill_block__(memory + prev_offset, ref_block, memory + curr_offset, pass != 0);
             }
         }
+
+        void fill_segment_i_table__(block *memory, uint32_t pass, uint32_t lane, uint32_t slice,
+                                    const uint32_t* table) const {
+            uint32_t starting_index = (pass == 0 && slice == 0) ? 2 : 0;
+            uint32_t curr_offset = lane * lane_length__ + slice * segment_length__ + starting_index;
+            uint32_t prev_offset = curr_offset + ((curr_offset % lane_length__ == 0) ? lane_length__ : 0) - 1;
+
+            derived__().fill_blocks__(memory + prev_offset, memory + curr_offset, segment_length__ - starting_index,
+                                      pass != 0, [&](uint32_t k, uint64_t) {
+                const uint32_t i = starting_index + k;
+                if (ARGON2_PREFETCH_DISTANCE > 0 && i + ARGON2_PREFETCH_DISTANCE < segment_length__)
+                    prefetch_block__(memory + table[i + ARGON2_PREFETCH_DISTANCE]);
+
+                return (const block*)(memory + table[i]);
+            });
+        }
     };
 }
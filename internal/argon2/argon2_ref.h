@@ -11,7 +11,7 @@ namespace argonishche {
         return x + y + 2 * xy;
     }
 
-    static inline void BlamkaGRef(uint64_t& a, uint64_t& b, uint64_t& c, uint64_t& d) {
+    static inline __attribute__((always_inline)) void BlamkaGRef(uint64_t& a, uint64_t& b, uint64_t& c, uint64_t& d) {
         a = FBlaMka(a, b);
         d = rotr(d ^ a, 32);
         c = FBlaMka(c, d);
@@ -22,7 +22,7 @@ namespace argonishche {
         b = rotr(b ^ c, 63);
 }
 
-    static inline void BlamkaRoundRef(
+    static inline __attribute__((always_inline)) void BlamkaRoundRef(
         uint64_t&  v0, uint64_t&  v1, uint64_t&  v2, uint64_t&  v3,
         uint64_t&  v4, uint64_t&  v5, uint64_t&  v6, uint64_t&  v7,
         uint64_t&  v8, uint64_t&  v9, uint64_t& v10, uint64_t& v11,
@@ -38,24 +38,29 @@ namespace argonishche {
         BlamkaGRef(v3, v4,  v9, v14);
     }
 
-    template<uint32_t mcost, uint32_t threads>
-    class Argon2REF final : public Argon2<InstructionSet::REF, mcost, threads> {
+    template<Argon2Type atype, uint32_t mcost, uint32_t threads>
+    class Argon2REF final : public Argon2<Argon2REF<atype, mcost, threads>, InstructionSet::REF, atype, mcost, threads> {
+        using Base = Argon2<Argon2REF<atype, mcost, threads>, InstructionSet::REF, atype, mcost, threads>;
+        friend Base;
+
     public:
-        Argon2REF(Argon2Type atype, uint32_t tcost, const uint8_t *key, uint32_t keylen)
-                : Argon2<InstructionSet::REF, mcost, threads>(atype, tcost, key, keylen) { }
+        Argon2REF(uint32_t tcost, const uint8_t *key, uint32_t keylen)
+                : Base(tcost, key, keylen) { }
 
     protected:
-        virtual void xor_block__(block *dst, const block *src) const override {
+        void xor_block__(block *dst, const block *src) const {
             for (uint32_t i = 0; i < ARGON2_QWORDS_IN_BLOCK; ++i) {
                 dst->v[i] ^= src->v[i];
             }
         }
 
-        virtual void copy_block__(block *dst, const block *src) const override {
+        void copy_block__(block *dst, const block *src) const {
             memcpy(dst->v, src->v, sizeof(uint64_t) * ARGON2_QWORDS_IN_BLOCK);
         }
 
-        virtual void fill_block__(const block *prev_block, const block *ref_block, block *next_block, bool with_xor) const override
+        template <class FirstWordCallback = Argon2IgnoreFirstWord>
+        void fill_block__(const block *prev_block, const block *ref_block, block *next_block, bool with_xor,
+                          FirstWordCallback first_word = FirstWordCallback()) const
         {
             block blockR, block_tmp;
             copy_block__(&blockR, ref_block);
@@ -79,6 +84,10 @@ namespace argonishche {
                         blockR.v[2 * i + 32], blockR.v[2 * i + 33], blockR.v[2 * i +  48], blockR.v[2 * i +  49],
                         blockR.v[2 * i + 64], blockR.v[2 * i + 65], blockR.v[2 * i +  80], blockR.v[2 * i +  81],
                         blockR.v[2 * i + 96], blockR.v[2 * i + 97], blockR.v[2 * i + 112], blockR.v[2 * i + 113]);
+
+                /* blockR.v[0] is final after the first columns, report the first word before the rest is done */
+                if (i == 0)
+                    first_word(blockR.v[0] ^ block_tmp.v[0]);
             }
 
             copy_block__(next_block, &block_tmp);
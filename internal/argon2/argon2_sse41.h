@@ -6,14 +6,17 @@
 
 namespace argonishche {
 
-    template<uint32_t mcost, uint32_t threads>
-    class Argon2SSE41 final : public Argon2<InstructionSet::SSE41, mcost, threads> {
+    template<Argon2Type atype, uint32_t mcost, uint32_t threads>
+    class Argon2SSE41 final : public Argon2<Argon2SSE41<atype, mcost, threads>, InstructionSet::SSE41, atype, mcost, threads> {
+        using Base = Argon2<Argon2SSE41<atype, mcost, threads>, InstructionSet::SSE41, atype, mcost, threads>;
+        friend Base;
+
     public:
-        Argon2SSE41(Argon2Type atype, uint32_t tcost, const uint8_t* key, uint32_t keylen)
-                : Argon2<InstructionSet::SSE41, mcost, threads>(atype, tcost, key, keylen) { }
+        Argon2SSE41(uint32_t tcost, const uint8_t* key, uint32_t keylen)
+                : Base(tcost, key, keylen) { }
 
     protected:
-        virtual void xor_block__(block *dst, const block *src) const override {
+        void xor_block__(block *dst, const block *src) const {
             __m128i* mdst = (__m128i*)dst;
             __m128i* msrc = (__m128i*)src;
 
@@ -21,11 +24,13 @@ namespace argonishche {
                 xor_values(mdst + i, msrc + i, mdst + i);
         }
 
-        virtual void copy_block__(block *dst, const block *src) const override {
+        void copy_block__(block *dst, const block *src) const {
             memcpy(dst->v, src->v, sizeof(uint64_t) * ARGON2_QWORDS_IN_BLOCK);
         }
 
-        virtual void fill_block__(const block *prev_block, const block *ref_block, block *next_block, bool with_xor) const override
+        template <class FirstWordCallback = Argon2IgnoreFirstWord>
+        void fill_block__(const block *prev_block, const block *ref_block, block *next_block, bool with_xor,
+                          FirstWordCallback first_word = FirstWordCallback()) const
         {
             __m128i block_XY[ARGON2_OWORDS_IN_BLOCK];
             __m128i state[ARGON2_OWORDS_IN_BLOCK];
@@ -102,6 +107,10 @@ namespace argonishche {
                         state[8 * 4 + i], state[8 * 5 + i],
                         state[8 * 6 + i], state[8 * 7 + i]
                 );
+
+                /* state[0] is final after the first columns, report the first word before the rest is done */
+                if (i == 0)
+                    first_word((uint64_t)_mm_cvtsi128_si64(_mm_xor_si128(state[0], block_XY[0])));
             }
 
             for (uint32_t i = 0; i < ARGON2_OWORDS_IN_BLOCK; ++i) {
@@ -5,6 +5,7 @@
 #include <cstring>
 #include <stdexcept>
 #include "argonishche.h"
+#include "blake2b_consts.h"
 
 #define BLAKE2_PACKED(x) x __attribute__((packed))
 
@@ -61,9 +62,35 @@ namespace argonishche {
         blake2b_param param__;
 
     protected:
-        void compress__(const uint8_t block[BLAKE2B_BLOCKBYTES]);
+        /* Specializations are always inlined, so constant h, t and f of Hash64 fold into the code */
+        static void compress__(uint64_t h[8], const uint64_t t[2], const uint64_t f[2],
+                               const uint8_t block[BLAKE2B_BLOCKBYTES]);
         void initial_xor__(uint8_t* h, const uint8_t* p);
 
+        void compress__(const uint8_t block[BLAKE2B_BLOCKBYTES]) {
+            compress__(state__.h, state__.t, state__.f, block);
+        }
+
+        /**
+         * Compresses count contiguous blocks that are not the last ones. h and the counter are kept
+         * in local variables for the whole run, so the inlined compressions don't reload them from the state
+         */
+        static void compress_blocks__(uint64_t h[8], uint64_t t[2], const uint8_t* blocks, size_t count) {
+            uint64_t hr[8];
+            uint64_t tr[2] = { t[0], t[1] };
+            const uint64_t f[2] = { 0, 0 };
+
+            memcpy(hr, h, sizeof(hr));
+            for (size_t i = 0; i < count; ++i, blocks += BLAKE2B_BLOCKBYTES) {
+                tr[0] += BLAKE2B_BLOCKBYTES;
+                tr[1] += (tr[0] < BLAKE2B_BLOCKBYTES) ? 1 : 0;
+                compress__(hr, tr, f, blocks);
+            }
+            memcpy(h, hr, sizeof(hr));
+            t[0] = tr[0];
+            t[1] = tr[1];
+        }
+
         static void secure_zero_memory__(void* src, size_t len) {
             static void *(*const volatile memset_v)(void *, int, size_t) = &memset;
             memset_v(src, 0, len);
@@ -99,6 +126,30 @@ namespace argonishche {
         }
 
     public:
+        /**
+         * Blake2B-512 of exactly 64 bytes without a key, i.e. a single compression of a zero-padded block
+         * with the default parameter block. It gives the same result as Update(in, 64) and Final(out, 64)
+         * but skips the state setup and buffering
+         */
+        static void Hash64(uint8_t out[BLAKE2B_OUTBYTES], const uint8_t in[BLAKE2B_OUTBYTES]) {
+            /* digest_length = 64, fanout = 1, depth = 1 */
+            uint64_t h[8] = {
+                    blake2b_iv[0] ^ 0x01010040ULL, blake2b_iv[1], blake2b_iv[2], blake2b_iv[3],
+                    blake2b_iv[4], blake2b_iv[5], blake2b_iv[6], blake2b_iv[7]
+            };
+            const uint64_t t[2] = { BLAKE2B_OUTBYTES, 0 };
+            const uint64_t f[2] = { (uint64_t)-1, 0 };
+            uint8_t block[BLAKE2B_BLOCKBYTES];
+
+            memcpy(block, in, BLAKE2B_OUTBYTES);
+            memset(block + BLAKE2B_OUTBYTES, 0, BLAKE2B_BLOCKBYTES - BLAKE2B_OUTBYTES);
+            compress__(h, t, f, block);
+            memcpy(out, h, BLAKE2B_OUTBYTES);
+
+            secure_zero_memory__(block, sizeof(block));
+            secure_zero_memory__(h, sizeof(h));
+        }
+
         Blake2B(size_t outlen) {
             /*
              * Note that outlen check was moved to proxy class
@@ -165,11 +216,12 @@ namespace argonishche {
                     compress__(state__.buf); /* Compress */
                     in += fill;
                     inlen -= fill;
-                    while(inlen > BLAKE2B_BLOCKBYTES) {
-                        increment_counter__(BLAKE2B_BLOCKBYTES);
-                        compress__(in);
-                        in += BLAKE2B_BLOCKBYTES;
-                        inlen -= BLAKE2B_BLOCKBYTES;
+                    if(inlen > BLAKE2B_BLOCKBYTES) {
+                        /* the last block stays in the buffer for Final */
+                        size_t count = (inlen - 1) / BLAKE2B_BLOCKBYTES;
+                        compress_blocks__(state__.h, state__.t, in, count);
+                        in += count * BLAKE2B_BLOCKBYTES;
+                        inlen -= count * BLAKE2B_BLOCKBYTES;
                     }
                 }
                 memcpy(state__.buf + state__.buflen, in, inlen);
@@ -2,6 +2,7 @@
 
 #include <immintrin.h>
 #include "blake2b.h"
+#include "load_avx2.h"
 #include "internal/rotations/rotations_avx2.h"
 
 namespace argonishche {
@@ -28,26 +29,16 @@ namespace argonishche {
      * b =  v4,  v5,  v6,  v7
      * c =  v8,  v9, v10, v11
      * d = v12, v13, v14, v15
+     *
+     * The rounds are unrolled in compress__, so GCC stops inlining this function without a hint.
      */
-    static inline void G1_AVX2(uint32_t r, __m256i& a, __m256i& b, __m256i& c, __m256i& d, uint64_t* blk, const __m128i vindex[12][4]) {
-        a = _mm256_add_epi64(a, _mm256_add_epi64(b, _mm256_i32gather_epi64((long long int*)blk, vindex[r][0], 8)));
+    static inline __attribute__((always_inline)) void G1_AVX2(__m256i& a, __m256i& b, __m256i& c, __m256i& d, __m256i b0, __m256i b1) {
+        a = _mm256_add_epi64(_mm256_add_epi64(a, b0), b);
         d = rotr32(_mm256_xor_si256(a, d));
         c = _mm256_add_epi64(c, d);
         b = rotr24(_mm256_xor_si256(b, c));
 
-        a = _mm256_add_epi64(a, _mm256_add_epi64(b, _mm256_i32gather_epi64((long long int*)blk, vindex[r][1], 8)));
-        d = rotr16(_mm256_xor_si256(a, d));
-        c = _mm256_add_epi64(c, d);
-        b = rotr63(_mm256_xor_si256(b, c));
-    }
-
-    static inline void G2_AVX2(uint32_t r, __m256i& a, __m256i& b, __m256i& c, __m256i& d, uint64_t* blk, const __m128i vindex[12][4]) {
-        a = _mm256_add_epi64(a, _mm256_add_epi64(b, _mm256_i32gather_epi64((long long int*)blk, vindex[r][2], 8)));
-        d = rotr32(_mm256_xor_si256(a, d));
-        c = _mm256_add_epi64(c, d);
-        b = rotr24(_mm256_xor_si256(b, c));
-
-        a = _mm256_add_epi64(a, _mm256_add_epi64(b, _mm256_i32gather_epi64((long long int*)blk, vindex[r][3], 8)));
+        a = _mm256_add_epi64(_mm256_add_epi64(a, b1), b);
         d = rotr16(_mm256_xor_si256(a, d));
         c = _mm256_add_epi64(c, d);
         b = rotr63(_mm256_xor_si256(b, c));
@@ -65,9 +56,38 @@ namespace argonishche {
         d = _mm256_permute4x64_epi64(d, _MM_SHUFFLE(0, 3, 2, 1));
     }
 
+#ifdef ARGONISHCHE_AVX2_GATHER
+    static inline __m256i GATHER_MSG_AVX2(const uint8_t* blk, __m128i vindex) {
+        return _mm256_i32gather_epi64((const long long int*)blk, vindex, 8);
+    }
+
+#define ROUND_AVX2(r) \
+    G1_AVX2(a, b, c, d, GATHER_MSG_AVX2(block, vindex[r][0]), GATHER_MSG_AVX2(block, vindex[r][1])); \
+    B_DIAGONALIZE(b, c, d); \
+    G1_AVX2(a, b, c, d, GATHER_MSG_AVX2(block, vindex[r][2]), GATHER_MSG_AVX2(block, vindex[r][3])); \
+    B_UNDIAGONALIZE(b, c, d);
+#else
+#define ROUND_AVX2(r) \
+    LOAD_MSG_AVX2_ ##r ##_1(b0); \
+    LOAD_MSG_AVX2_ ##r ##_2(b1); \
+    G1_AVX2(a, b, c, d, b0, b1); \
+    B_DIAGONALIZE(b, c, d); \
+    LOAD_MSG_AVX2_ ##r ##_3(b0); \
+    LOAD_MSG_AVX2_ ##r ##_4(b1); \
+    G1_AVX2(a, b, c, d, b0, b1); \
+    B_UNDIAGONALIZE(b, c, d);
+#endif
+
+    /*
+     * By default message words are picked with in-lane shuffles (see load_avx2.h)
+     * as gathers are slow on AMD and older Intel CPUs.
+     * Define ARGONISHCHE_AVX2_GATHER to load them with _mm256_i32gather_epi64 instead.
+     */
     template<>
-    void Blake2B<InstructionSet::AVX2>::compress__(const uint8_t block[BLAKE2B_BLOCKBYTES]) {
+    inline __attribute__((always_inline)) void Blake2B<InstructionSet::AVX2>::compress__(
+            uint64_t h[8], const uint64_t t[2], const uint64_t f[2], const uint8_t block[BLAKE2B_BLOCKBYTES]) {
         static const __m256i* iv = get_avx_iv();
+#ifdef ARGONISHCHE_AVX2_GATHER
         static const __m128i vindex[12][4] = {
                 { _mm_set_epi32( 6,  4,  2,  0), _mm_set_epi32( 7,  5,  3,  1), _mm_set_epi32(14, 12, 10,  8), _mm_set_epi32(15, 13, 11,  9) },
                 { _mm_set_epi32(13,  9,  4, 14), _mm_set_epi32( 6, 15,  8, 10), _mm_set_epi32( 5, 11,  0,  1), _mm_set_epi32( 3,  7,  2, 12) },
@@ -82,27 +102,46 @@ namespace argonishche {
                 { _mm_set_epi32( 6,  4,  2,  0), _mm_set_epi32( 7,  5,  3,  1), _mm_set_epi32(14, 12, 10,  8), _mm_set_epi32(15, 13, 11,  9) },
                 { _mm_set_epi32(13,  9,  4, 14), _mm_set_epi32( 6, 15,  8, 10), _mm_set_epi32( 5, 11,  0,  1), _mm_set_epi32( 3,  7,  2, 12) },
         };
+#else
+        const __m128i* block_ptr = (__m128i*)block;
+        const __m256i m0 = _mm256_broadcastsi128_si256(_mm_loadu_si128(block_ptr + 0));
+        const __m256i m1 = _mm256_broadcastsi128_si256(_mm_loadu_si128(block_ptr + 1));
+        const __m256i m2 = _mm256_broadcastsi128_si256(_mm_loadu_si128(block_ptr + 2));
+        const __m256i m3 = _mm256_broadcastsi128_si256(_mm_loadu_si128(block_ptr + 3));
+        const __m256i m4 = _mm256_broadcastsi128_si256(_mm_loadu_si128(block_ptr + 4));
+        const __m256i m5 = _mm256_broadcastsi128_si256(_mm_loadu_si128(block_ptr + 5));
+        const __m256i m6 = _mm256_broadcastsi128_si256(_mm_loadu_si128(block_ptr + 6));
+        const __m256i m7 = _mm256_broadcastsi128_si256(_mm_loadu_si128(block_ptr + 7));
+        __m256i t0, t1, b0, b1;
+#endif
 
-        __m256i a = _mm256_loadu_si256((__m256i*)&state__.h[0]);
-        __m256i b = _mm256_loadu_si256((__m256i*)&state__.h[4]);
+        __m256i a = _mm256_loadu_si256((__m256i*)&h[0]);
+        __m256i b = _mm256_loadu_si256((__m256i*)&h[4]);
         __m256i c = iv[0];
-        __m256i d = _mm256_xor_si256(iv[1], _mm256_loadu_si256((__m256i*)&state__.t[0]));
+        __m256i d = _mm256_xor_si256(iv[1], _mm256_set_epi64x(f[1], f[0], t[1], t[0]));
 
-        for(uint32_t r = 0; r < 12; ++r)
-        {
-            G1_AVX2(r, a, b, c, d, (uint64_t*)block, vindex);
-            B_DIAGONALIZE(b, c, d);
-            G2_AVX2(r, a, b, c, d, (uint64_t*)block, vindex);
-            B_UNDIAGONALIZE(b, c, d);
-        }
+        ROUND_AVX2(0);
+        ROUND_AVX2(1);
+        ROUND_AVX2(2);
+        ROUND_AVX2(3);
+        ROUND_AVX2(4);
+        ROUND_AVX2(5);
+        ROUND_AVX2(6);
+        ROUND_AVX2(7);
+        ROUND_AVX2(8);
+        ROUND_AVX2(9);
+        ROUND_AVX2(10);
+        ROUND_AVX2(11);
 
-        _mm256_storeu_si256((__m256i*)state__.h, _mm256_xor_si256(
-                _mm256_loadu_si256((__m256i*)state__.h),
+        _mm256_storeu_si256((__m256i*)h, _mm256_xor_si256(
+                _mm256_loadu_si256((__m256i*)h),
                 _mm256_xor_si256(a, c)
         ));
-        _mm256_storeu_si256(((__m256i*)state__.h) + 1, _mm256_xor_si256(
-                _mm256_loadu_si256(((__m256i*)state__.h) + 1),
+        _mm256_storeu_si256(((__m256i*)h) + 1, _mm256_xor_si256(
+                _mm256_loadu_si256(((__m256i*)h) + 1),
                 _mm256_xor_si256(b, d)
         ));
     }
+
+#undef ROUND_AVX2
 }
@@ -0,0 +1,120 @@
+#pragma once
+
+#include <immintrin.h>
+#include "blake2b.h"
+#include "internal/rotations/rotations_avx512.h"
+
+namespace argonishche {
+    static const __m256i* get_avx512_iv() {
+        static const __m256i iv[2] = {
+                _mm256_set_epi64x(0xa54ff53a5f1d36f1ULL, 0x3c6ef372fe94f82bULL, 0xbb67ae8584caa73bULL, 0x6a09e667f3bcc908ULL),
+                _mm256_set_epi64x(0x5be0cd19137e2179ULL, 0x1f83d9abfb41bd6bULL, 0x9b05688c2b3e6c1fULL, 0x510e527fade682d1ULL)
+        };
+
+        return iv;
+    }
+
+    template<>
+    void Blake2B<InstructionSet::AVX512>::initial_xor__(uint8_t *h, const uint8_t *p) {
+        static const __m256i* iv = get_avx512_iv();
+        __m256i* m_res = (__m256i*)h;
+        const __m256i* m_second = (__m256i*)p;
+        _mm256_storeu_si256(m_res, _mm256_xor_si256(iv[0], _mm256_loadu_si256(m_second)));
+        _mm256_storeu_si256(m_res + 1, _mm256_xor_si256(iv[1], _mm256_loadu_si256(m_second + 1)));
+    }
+
+    /*
+     * a =  v0,  v1,  v2,  v3
+     * b =  v4,  v5,  v6,  v7
+     * c =  v8,  v9, v10, v11
+     * d = v12, v13, v14, v15
+     */
+    static inline void G_AVX512(__m256i& a, __m256i& b, __m256i& c, __m256i& d, __m256i m0, __m256i m1) {
+        a = _mm256_add_epi64(_mm256_add_epi64(a, m0), b);
+        d = rotr32(_mm256_xor_si256(a, d));
+        c = _mm256_add_epi64(c, d);
+        b = rotr24(_mm256_xor_si256(b, c));
+
+        a = _mm256_add_epi64(_mm256_add_epi64(a, m1), b);
+        d = rotr16(_mm256_xor_si256(a, d));
+        c = _mm256_add_epi64(c, d);
+        b = rotr63(_mm256_xor_si256(b, c));
+    }
+
+    /*
+     * Picks 8 message words out of 16 ones stored in two registers with a single vpermt2q.
+     * The lower half of the result goes to the first addition in G, the upper one goes to the second
+     */
+    static inline void LOAD_MSG_AVX512(__m256i& m0, __m256i& m1, __m512i lo, __m512i hi, __m512i idx) {
+        __m512i m = _mm512_permutex2var_epi64(lo, idx, hi);
+        m0 = _mm512_castsi512_si256(m);
+        m1 = _mm512_extracti64x4_epi64(m, 1);
+    }
+
+    /*
+     * b is the last row computed by G, so it stays in place and a, c, d are rotated instead.
+     * Their permutations are off the critical path as these rows are ready earlier.
+     * Lane k then holds (v[k - 1], v[4 + k], v[8 + k + 1], v[12 + k + 2]) (indices mod 4),
+     * so the message words of the diagonal step are rotated accordingly.
+     */
+    static inline void B_DIAGONALIZE_AVX512(__m256i& a, __m256i& c, __m256i& d) {
+        a = _mm256_permutex_epi64(a, _MM_SHUFFLE(2, 1, 0, 3));
+        c = _mm256_permutex_epi64(c, _MM_SHUFFLE(0, 3, 2, 1));
+        d = _mm256_permutex_epi64(d, _MM_SHUFFLE(1, 0, 3, 2));
+    }
+
+    static inline void B_UNDIAGONALIZE_AVX512(__m256i& a, __m256i& c, __m256i& d) {
+        a = _mm256_permutex_epi64(a, _MM_SHUFFLE(0, 3, 2, 1));
+        c = _mm256_permutex_epi64(c, _MM_SHUFFLE(2, 1, 0, 3));
+        d = _mm256_permutex_epi64(d, _MM_SHUFFLE(1, 0, 3, 2));
+    }
+
+    template<>
+    inline __attribute__((always_inline)) void Blake2B<InstructionSet::AVX512>::compress__(
+            uint64_t h[8], const uint64_t t[2], const uint64_t f[2], const uint8_t block[BLAKE2B_BLOCKBYTES]) {
+        static const __m256i* iv = get_avx512_iv();
+        /* sigma[r] split into the column step and the (rotated) diagonal step message words */
+        static const __m512i sidx[12][2] = {
+                { _mm512_setr_epi64( 0,  2,  4,  6,  1,  3,  5,  7), _mm512_setr_epi64(14,  8, 10, 12, 15,  9, 11, 13) },
+                { _mm512_setr_epi64(14,  4,  9, 13, 10,  8, 15,  6), _mm512_setr_epi64( 5,  1,  0, 11,  3, 12,  2,  7) },
+                { _mm512_setr_epi64(11, 12,  5, 15,  8,  0,  2, 13), _mm512_setr_epi64( 9, 10,  3,  7,  4, 14,  6,  1) },
+                { _mm512_setr_epi64( 7,  3, 13, 11,  9,  1, 12, 14), _mm512_setr_epi64(15,  2,  5,  4,  8,  6, 10,  0) },
+                { _mm512_setr_epi64( 9,  5,  2, 10,  0,  7,  4, 15), _mm512_setr_epi64( 3, 14, 11,  6, 13,  1, 12,  8) },
+                { _mm512_setr_epi64( 2,  6,  0,  8, 12, 10, 11,  3), _mm512_setr_epi64( 1,  4,  7, 15,  9, 13,  5, 14) },
+                { _mm512_setr_epi64(12,  1, 14,  4,  5, 15, 13, 10), _mm512_setr_epi64( 8,  0,  6,  9, 11,  7,  3,  2) },
+                { _mm512_setr_epi64(13,  7, 12,  3, 11, 14,  1,  9), _mm512_setr_epi64( 2,  5, 15,  8, 10,  0,  4,  6) },
+                { _mm512_setr_epi64( 6, 14, 11,  0, 15,  9,  3,  8), _mm512_setr_epi64(10, 12, 13,  1,  5,  2,  7,  4) },
+                { _mm512_setr_epi64(10,  8,  7,  1,  2,  4,  6,  5), _mm512_setr_epi64(13, 15,  9,  3,  0, 11, 14, 12) },
+                { _mm512_setr_epi64( 0,  2,  4,  6,  1,  3,  5,  7), _mm512_setr_epi64(14,  8, 10, 12, 15,  9, 11, 13) },
+                { _mm512_setr_epi64(14,  4,  9, 13, 10,  8, 15,  6), _mm512_setr_epi64( 5,  1,  0, 11,  3, 12,  2,  7) },
+        };
+
+        const __m512i mlo = _mm512_loadu_si512((const __m512i*)block);
+        const __m512i mhi = _mm512_loadu_si512((const __m512i*)block + 1);
+
+        __m256i a = _mm256_loadu_si256((__m256i*)&h[0]);
+        __m256i b = _mm256_loadu_si256((__m256i*)&h[4]);
+        __m256i c = iv[0];
+        __m256i d = _mm256_xor_si256(iv[1], _mm256_set_epi64x(f[1], f[0], t[1], t[0]));
+        __m256i m0, m1;
+
+        for(uint32_t r = 0; r < 12; ++r)
+        {
+            LOAD_MSG_AVX512(m0, m1, mlo, mhi, sidx[r][0]);
+            G_AVX512(a, b, c, d, m0, m1);
+            B_DIAGONALIZE_AVX512(a, c, d);
+            LOAD_MSG_AVX512(m0, m1, mlo, mhi, sidx[r][1]);
+            G_AVX512(a, b, c, d, m0, m1);
+            B_UNDIAGONALIZE_AVX512(a, c, d);
+        }
+
+        _mm256_storeu_si256((__m256i*)h, _mm256_xor_si256(
+                _mm256_loadu_si256((__m256i*)h),
+                _mm256_xor_si256(a, c)
+        ));
+        _mm256_storeu_si256(((__m256i*)h) + 1, _mm256_xor_si256(
+                _mm256_loadu_si256(((__m256i*)h) + 1),
+                _mm256_xor_si256(b, d)
+        ));
+    }
+}
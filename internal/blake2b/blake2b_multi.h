@@ -0,0 +1,158 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <algorithm>
+#include <type_traits>
+#include "argonishche.h"
+#include "blake2b.h"
+#include "blake2b_consts.h"
+
+namespace argonishche {
+    /**
+     * The number of messages hashed in parallel, i.e. the number of 64-bit words in a SIMD register.
+     * The reference version processes 4 messages in a row to share the code with the AVX2 one.
+     */
+    template <InstructionSet instructionSet>
+    struct Blake2BMultiLanes {
+        static const uint32_t value = 4;
+    };
+
+    template <>
+    struct Blake2BMultiLanes<InstructionSet::AVX512> {
+        static const uint32_t value = 8;
+    };
+
+    /**
+     * true_type if the instruction set has a vectorized multi-buffer kernel.
+     * The reference one only shares the interface and doesn't run faster than serial hashing.
+     */
+    template <InstructionSet instructionSet>
+    struct Blake2BMultiVectorized : std::integral_constant<bool,
+            instructionSet == InstructionSet::AVX2 || instructionSet == InstructionSet::AVX512> { };
+
+    template <InstructionSet instructionSet>
+    class Blake2BMulti final : public Blake2MultiBase {
+    public:
+        static const uint32_t LANES = Blake2BMultiLanes<instructionSet>::value;
+
+        Blake2BMulti(size_t outlen, const void* key = nullptr, size_t keylen = 0)
+                : outlen__(outlen), keylen__(keylen) {
+            /*
+             * Note that key and outlen checks were moved to proxy classes
+             */
+            memset(key__, 0, sizeof(key__));
+            if (keylen > 0)
+                memcpy(key__, key, keylen);
+
+            /* parameter block with fanout = 1 and depth = 1, all the other fields but lengths are zero */
+            for (uint32_t i = 0; i < 8; ++i)
+                h0__[i] = blake2b_iv[i];
+            h0__[0] ^= 0x01010000ULL ^ ((uint64_t)keylen << 8) ^ (uint64_t)outlen;
+        }
+
+        virtual ~Blake2BMulti<instructionSet>() {
+            secure_zero_memory__(key__, sizeof(key__));
+        }
+
+        void Hash(const uint8_t* const* in, const size_t* inlen, uint8_t* const* out, size_t count) const override {
+            for (size_t first = 0; first < count; first += LANES)
+                hash_group__(in + first, inlen + first, out + first, std::min<size_t>(LANES, count - first));
+        }
+
+        uint32_t GetLanes() const override {
+            return LANES;
+        }
+
+    protected:
+        size_t outlen__;
+        size_t keylen__;
+        uint64_t h0__[8];
+        uint8_t key__[BLAKE2B_BLOCKBYTES];
+
+        /**
+         * Compresses one block of every lane.
+         * The state is transposed: h[LANES * i + l] is the i-th word of the l-th lane state
+         * @param h transposed state, 64-byte aligned
+         * @param blocks pointers to the message blocks of the lanes
+         * @param t byte counters of the lanes
+         * @param f finalization flags of the lanes
+         */
+        void compress__(uint64_t* h, const uint8_t* const* blocks, const uint64_t* t, const uint64_t* f) const;
+
+        static void secure_zero_memory__(void* src, size_t len) {
+            static void *(*const volatile memset_v)(void *, int, size_t) = &memset;
+            memset_v(src, 0, len);
+        }
+
+        /**
+         * Hashes up to LANES messages. Messages may take a different number of blocks,
+         * so a lane that has already finished keeps compressing garbage until the longest message is done.
+         */
+        void hash_group__(const uint8_t* const* in, const size_t* inlen, uint8_t* const* out, size_t n) const {
+            alignas(64) uint64_t h[8 * LANES];
+            alignas(64) uint8_t pad[LANES][BLAKE2B_BLOCKBYTES];
+            const uint8_t* blocks[LANES];
+            uint64_t t[LANES], f[LANES], nblocks[LANES];
+            const uint64_t keyblocks = keylen__ > 0 ? 1 : 0;
+            uint64_t steps = 0;
+
+            memset(pad, 0, sizeof(pad));
+            for (uint32_t l = 0; l < LANES; ++l) {
+                for (uint32_t i = 0; i < 8; ++i)
+                    h[LANES * i + l] = h0__[i];
+
+                if (l < n) {
+                    uint64_t total = keyblocks * BLAKE2B_BLOCKBYTES + inlen[l];
+                    nblocks[l] = std::max<uint64_t>(1, (total + BLAKE2B_BLOCKBYTES - 1) / BLAKE2B_BLOCKBYTES);
+                } else {
+                    nblocks[l] = 0;
+                }
+                steps = std::max(steps, nblocks[l]);
+            }
+
+            for (uint64_t s = 0; s < steps; ++s) {
+                for (uint32_t l = 0; l < LANES; ++l) {
+                    t[l] = f[l] = 0;
+                    blocks[l] = pad[l];
+                    if (l >= n || s >= nblocks[l])
+                        continue;
+
+                    if (s < keyblocks) {
+                        blocks[l] = key__;
+                    } else {
+                        size_t offset = (s - keyblocks) * BLAKE2B_BLOCKBYTES;
+                        size_t left = inlen[l] - offset;
+                        if (left >= BLAKE2B_BLOCKBYTES) {
+                            blocks[l] = in[l] + offset;
+                        } else {
+                            memset(pad[l], 0, BLAKE2B_BLOCKBYTES);
+                            if (left > 0)
+                                memcpy(pad[l], in[l] + offset, left);
+                        }
+                    }
+
+                    t[l] = std::min<uint64_t>(keyblocks * BLAKE2B_BLOCKBYTES + inlen[l], (s + 1) * BLAKE2B_BLOCKBYTES);
+                    f[l] = (s + 1 == nblocks[l]) ? (uint64_t)-1 : 0;
+                }
+
+                compress__(h, blocks, t, f);
+
+                for (uint32_t l = 0; l < n; ++l) {
+                    if (s + 1 != nblocks[l])
+                        continue;
+
+                    uint64_t digest[8];
+                    for (uint32_t i = 0; i < 8; ++i)
+                        digest[i] = h[LANES * i + l];
+                    memcpy(out[l], digest, outlen__);
+                    secure_zero_memory__(digest, sizeof(digest));
+                }
+            }
+
+            secure_zero_memory__(h, sizeof(h));
+            secure_zero_memory__(pad, sizeof(pad));
+        }
+    };
+}
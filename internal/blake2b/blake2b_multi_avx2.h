@@ -0,0 +1,80 @@
+#pragma once
+
+#include <immintrin.h>
+#include "blake2b_multi.h"
+#include "internal/rotations/rotations_avx2.h"
+
+namespace argonishche {
+    /*
+     * Every register holds the same state word of 4 different messages
+     */
+    static inline void G_MULTI_AVX2(__m256i& a, __m256i& b, __m256i& c, __m256i& d, __m256i x, __m256i y) {
+        a = _mm256_add_epi64(_mm256_add_epi64(a, x), b);
+        d = rotr32(_mm256_xor_si256(d, a));
+        c = _mm256_add_epi64(c, d);
+        b = rotr24(_mm256_xor_si256(b, c));
+
+        a = _mm256_add_epi64(_mm256_add_epi64(a, y), b);
+        d = rotr16(_mm256_xor_si256(d, a));
+        c = _mm256_add_epi64(c, d);
+        b = rotr63(_mm256_xor_si256(b, c));
+    }
+
+    /* r0..r3 hold words 0..3 of lanes 0..3, w[i] gets word i of all the lanes */
+    static inline void TRANSPOSE_4X4_AVX2(__m256i* w, __m256i r0, __m256i r1, __m256i r2, __m256i r3) {
+        __m256i t0 = _mm256_unpacklo_epi64(r0, r1);
+        __m256i t1 = _mm256_unpackhi_epi64(r0, r1);
+        __m256i t2 = _mm256_unpacklo_epi64(r2, r3);
+        __m256i t3 = _mm256_unpackhi_epi64(r2, r3);
+
+        w[0] = _mm256_permute2x128_si256(t0, t2, 0x20);
+        w[1] = _mm256_permute2x128_si256(t1, t3, 0x20);
+        w[2] = _mm256_permute2x128_si256(t0, t2, 0x31);
+        w[3] = _mm256_permute2x128_si256(t1, t3, 0x31);
+    }
+
+    template<>
+    void Blake2BMulti<InstructionSet::AVX2>::compress__(uint64_t* h, const uint8_t* const* blocks,
+                                                        const uint64_t* t, const uint64_t* f) const {
+        __m256i m[16];
+        __m256i v[16];
+
+        for (uint32_t i = 0; i < 4; ++i) {
+            TRANSPOSE_4X4_AVX2(m + 4 * i,
+                    _mm256_loadu_si256((const __m256i*)blocks[0] + i),
+                    _mm256_loadu_si256((const __m256i*)blocks[1] + i),
+                    _mm256_loadu_si256((const __m256i*)blocks[2] + i),
+                    _mm256_loadu_si256((const __m256i*)blocks[3] + i));
+        }
+
+        for (uint32_t i = 0; i < 8; ++i)
+            v[i] = _mm256_load_si256((const __m256i*)h + i);
+
+        v[ 8] = _mm256_set1_epi64x(blake2b_iv[0]);
+        v[ 9] = _mm256_set1_epi64x(blake2b_iv[1]);
+        v[10] = _mm256_set1_epi64x(blake2b_iv[2]);
+        v[11] = _mm256_set1_epi64x(blake2b_iv[3]);
+        v[12] = _mm256_xor_si256(_mm256_set1_epi64x(blake2b_iv[4]), _mm256_loadu_si256((const __m256i*)t));
+        v[13] = _mm256_set1_epi64x(blake2b_iv[5]);
+        v[14] = _mm256_xor_si256(_mm256_set1_epi64x(blake2b_iv[6]), _mm256_loadu_si256((const __m256i*)f));
+        v[15] = _mm256_set1_epi64x(blake2b_iv[7]);
+
+        for (uint32_t r = 0; r < 12; ++r) {
+            G_MULTI_AVX2(v[0], v[4], v[ 8], v[12], m[blake2b_sigma[r][ 0]], m[blake2b_sigma[r][ 1]]);
+            G_MULTI_AVX2(v[1], v[5], v[ 9], v[13], m[blake2b_sigma[r][ 2]], m[blake2b_sigma[r][ 3]]);
+            G_MULTI_AVX2(v[2], v[6], v[10], v[14], m[blake2b_sigma[r][ 4]], m[blake2b_sigma[r][ 5]]);
+            G_MULTI_AVX2(v[3], v[7], v[11], v[15], m[blake2b_sigma[r][ 6]], m[blake2b_sigma[r][ 7]]);
+            G_MULTI_AVX2(v[0], v[5], v[10], v[15], m[blake2b_sigma[r][ 8]], m[blake2b_sigma[r][ 9]]);
+            G_MULTI_AVX2(v[1], v[6], v[11], v[12], m[blake2b_sigma[r][10]], m[blake2b_sigma[r][11]]);
+            G_MULTI_AVX2(v[2], v[7], v[ 8], v[13], m[blake2b_sigma[r][12]], m[blake2b_sigma[r][13]]);
+            G_MULTI_AVX2(v[3], v[4], v[ 9], v[14], m[blake2b_sigma[r][14]], m[blake2b_sigma[r][15]]);
+        }
+
+        for (uint32_t i = 0; i < 8; ++i) {
+            _mm256_store_si256((__m256i*)h + i, _mm256_xor_si256(
+                    _mm256_load_si256((const __m256i*)h + i),
+                    _mm256_xor_si256(v[i], v[i + 8])
+            ));
+        }
+    }
+}
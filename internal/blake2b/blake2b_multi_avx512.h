@@ -0,0 +1,98 @@
+#pragma once
+
+#include <immintrin.h>
+#include "blake2b_multi.h"
+#include "internal/rotations/rotations_avx512.h"
+
+namespace argonishche {
+    /*
+     * Every register holds the same state word of 8 different messages
+     */
+    static inline void G_MULTI_AVX512(__m512i& a, __m512i& b, __m512i& c, __m512i& d, __m512i x, __m512i y) {
+        a = _mm512_add_epi64(_mm512_add_epi64(a, x), b);
+        d = rotr32(_mm512_xor_si512(d, a));
+        c = _mm512_add_epi64(c, d);
+        b = rotr24(_mm512_xor_si512(b, c));
+
+        a = _mm512_add_epi64(_mm512_add_epi64(a, y), b);
+        d = rotr16(_mm512_xor_si512(d, a));
+        c = _mm512_add_epi64(c, d);
+        b = rotr63(_mm512_xor_si512(b, c));
+    }
+
+    /* r[l] holds words 0..7 of lane l, w[i] gets word i of all the lanes */
+    static inline void TRANSPOSE_8X8_AVX512(__m512i* w, const __m512i* r) {
+        /* pairs of lanes: (r0[0], r1[0], r0[2], r1[2], ...) and (r0[1], r1[1], r0[3], r1[3], ...) */
+        __m512i t0 = _mm512_unpacklo_epi64(r[0], r[1]);
+        __m512i t1 = _mm512_unpackhi_epi64(r[0], r[1]);
+        __m512i t2 = _mm512_unpacklo_epi64(r[2], r[3]);
+        __m512i t3 = _mm512_unpackhi_epi64(r[2], r[3]);
+        __m512i t4 = _mm512_unpacklo_epi64(r[4], r[5]);
+        __m512i t5 = _mm512_unpackhi_epi64(r[4], r[5]);
+        __m512i t6 = _mm512_unpacklo_epi64(r[6], r[7]);
+        __m512i t7 = _mm512_unpackhi_epi64(r[6], r[7]);
+
+        /* quads of lanes: (r0[0], r1[0], r0[4], r1[4], r2[0], r3[0], r2[4], r3[4]) etc. */
+        __m512i u0 = _mm512_shuffle_i64x2(t0, t2, _MM_SHUFFLE(2, 0, 2, 0));
+        __m512i u1 = _mm512_shuffle_i64x2(t1, t3, _MM_SHUFFLE(2, 0, 2, 0));
+        __m512i u2 = _mm512_shuffle_i64x2(t0, t2, _MM_SHUFFLE(3, 1, 3, 1));
+        __m512i u3 = _mm512_shuffle_i64x2(t1, t3, _MM_SHUFFLE(3, 1, 3, 1));
+        __m512i u4 = _mm512_shuffle_i64x2(t4, t6, _MM_SHUFFLE(2, 0, 2, 0));
+        __m512i u5 = _mm512_shuffle_i64x2(t5, t7, _MM_SHUFFLE(2, 0, 2, 0));
+        __m512i u6 = _mm512_shuffle_i64x2(t4, t6, _MM_SHUFFLE(3, 1, 3, 1));
+        __m512i u7 = _mm512_shuffle_i64x2(t5, t7, _MM_SHUFFLE(3, 1, 3, 1));
+
+        w[0] = _mm512_shuffle_i64x2(u0, u4, _MM_SHUFFLE(2, 0, 2, 0));
+        w[1] = _mm512_shuffle_i64x2(u1, u5, _MM_SHUFFLE(2, 0, 2, 0));
+        w[2] = _mm512_shuffle_i64x2(u2, u6, _MM_SHUFFLE(2, 0, 2, 0));
+        w[3] = _mm512_shuffle_i64x2(u3, u7, _MM_SHUFFLE(2, 0, 2, 0));
+        w[4] = _mm512_shuffle_i64x2(u0, u4, _MM_SHUFFLE(3, 1, 3, 1));
+        w[5] = _mm512_shuffle_i64x2(u1, u5, _MM_SHUFFLE(3, 1, 3, 1));
+        w[6] = _mm512_shuffle_i64x2(u2, u6, _MM_SHUFFLE(3, 1, 3, 1));
+        w[7] = _mm512_shuffle_i64x2(u3, u7, _MM_SHUFFLE(3, 1, 3, 1));
+    }
+
+    template<>
+    void Blake2BMulti<InstructionSet::AVX512>::compress__(uint64_t* h, const uint8_t* const* blocks,
+                                                          const uint64_t* t, const uint64_t* f) const {
+        __m512i m[16];
+        __m512i v[16];
+
+        for (uint32_t i = 0; i < 2; ++i) {
+            __m512i r[8];
+            for (uint32_t l = 0; l < 8; ++l)
+                r[l] = _mm512_loadu_si512((const __m512i*)blocks[l] + i);
+            TRANSPOSE_8X8_AVX512(m + 8 * i, r);
+        }
+
+        for (uint32_t i = 0; i < 8; ++i)
+            v[i] = _mm512_load_si512((const __m512i*)h + i);
+
+        v[ 8] = _mm512_set1_epi64(blake2b_iv[0]);
+        v[ 9] = _mm512_set1_epi64(blake2b_iv[1]);
+        v[10] = _mm512_set1_epi64(blake2b_iv[2]);
+        v[11] = _mm512_set1_epi64(blake2b_iv[3]);
+        v[12] = _mm512_xor_si512(_mm512_set1_epi64(blake2b_iv[4]), _mm512_loadu_si512((const __m512i*)t));
+        v[13] = _mm512_set1_epi64(blake2b_iv[5]);
+        v[14] = _mm512_xor_si512(_mm512_set1_epi64(blake2b_iv[6]), _mm512_loadu_si512((const __m512i*)f));
+        v[15] = _mm512_set1_epi64(blake2b_iv[7]);
+
+        for (uint32_t r = 0; r < 12; ++r) {
+            G_MULTI_AVX512(v[0], v[4], v[ 8], v[12], m[blake2b_sigma[r][ 0]], m[blake2b_sigma[r][ 1]]);
+            G_MULTI_AVX512(v[1], v[5], v[ 9], v[13], m[blake2b_sigma[r][ 2]], m[blake2b_sigma[r][ 3]]);
+            G_MULTI_AVX512(v[2], v[6], v[10], v[14], m[blake2b_sigma[r][ 4]], m[blake2b_sigma[r][ 5]]);
+            G_MULTI_AVX512(v[3], v[7], v[11], v[15], m[blake2b_sigma[r][ 6]], m[blake2b_sigma[r][ 7]]);
+            G_MULTI_AVX512(v[0], v[5], v[10], v[15], m[blake2b_sigma[r][ 8]], m[blake2b_sigma[r][ 9]]);
+            G_MULTI_AVX512(v[1], v[6], v[11], v[12], m[blake2b_sigma[r][10]], m[blake2b_sigma[r][11]]);
+            G_MULTI_AVX512(v[2], v[7], v[ 8], v[13], m[blake2b_sigma[r][12]], m[blake2b_sigma[r][13]]);
+            G_MULTI_AVX512(v[3], v[4], v[ 9], v[14], m[blake2b_sigma[r][14]], m[blake2b_sigma[r][15]]);
+        }
+
+        for (uint32_t i = 0; i < 8; ++i) {
+            _mm512_store_si512((__m512i*)h + i, _mm512_xor_si512(
+                    _mm512_load_si512((const __m512i*)h + i),
+                    _mm512_xor_si512(v[i], v[i + 8])
+            ));
+        }
+    }
+}
@@ -0,0 +1,33 @@
+#pragma once
+
+#include "blake2b_multi.h"
+#include "blake2b_ref.h"
+
+namespace argonishche {
+    template<>
+    void Blake2BMulti<InstructionSet::REF>::compress__(uint64_t* h, const uint8_t* const* blocks,
+                                                       const uint64_t* t, const uint64_t* f) const {
+        for (uint32_t l = 0; l < LANES; ++l) {
+            uint64_t v[16];
+            const uint64_t* m = (const uint64_t*)blocks[l];
+
+            for (uint32_t i = 0; i < 8; ++i)
+                v[i] = h[LANES * i + l];
+
+            v[ 8] = blake2b_iv[0];
+            v[ 9] = blake2b_iv[1];
+            v[10] = blake2b_iv[2];
+            v[11] = blake2b_iv[3];
+            v[12] = blake2b_iv[4] ^ t[l];
+            v[13] = blake2b_iv[5];
+            v[14] = blake2b_iv[6] ^ f[l];
+            v[15] = blake2b_iv[7];
+
+            for (uint64_t r = 0; r < 12; ++r)
+                ROUND_REF(r, v, m);
+
+            for (uint32_t i = 0; i < 8; ++i)
+                h[LANES * i + l] ^= v[i] ^ v[i + 8];
+        }
+    }
+}
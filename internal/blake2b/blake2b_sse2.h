@@ -132,29 +132,30 @@ namespace argonishche {
         _mm_storeu_si128(m_res + 3, _mm_xor_si128(iv[3], _mm_loadu_si128(m_p + 3)));
     }
 
-    template <>
-    void Blake2B<InstructionSet::SSE2>::compress__(const uint8_t block[BLAKE2B_BLOCKBYTES]) {
+    template<>
+    inline __attribute__((always_inline)) void Blake2B<InstructionSet::SSE2>::compress__(
+            uint64_t h[8], const uint64_t t[2], const uint64_t f[2], const uint8_t block[BLAKE2B_BLOCKBYTES]) {
         static const __m128i* iv = get_iv();
         const uint64_t* block_ptr = (uint64_t*)block;
-        __m128i row1l = _mm_loadu_si128((__m128i*)&state__.h[0]);
-        __m128i row1h = _mm_loadu_si128((__m128i*)&state__.h[2]);
-        __m128i row2l = _mm_loadu_si128((__m128i*)&state__.h[4]);
-        __m128i row2h = _mm_loadu_si128((__m128i*)&state__.h[6]);
+        __m128i row1l = _mm_loadu_si128((__m128i*)&h[0]);
+        __m128i row1h = _mm_loadu_si128((__m128i*)&h[2]);
+        __m128i row2l = _mm_loadu_si128((__m128i*)&h[4]);
+        __m128i row2h = _mm_loadu_si128((__m128i*)&h[6]);
         __m128i row3l = iv[0];
         __m128i row3h = iv[1];
-        __m128i row4l = _mm_xor_si128(iv[2], _mm_loadu_si128((__m128i*)&state__.t[0]));
-        __m128i row4h = _mm_xor_si128(iv[3], _mm_loadu_si128((__m128i*)&state__.f[0]));
+        __m128i row4l = _mm_xor_si128(iv[2], _mm_loadu_si128((__m128i*)&t[0]));
+        __m128i row4h = _mm_xor_si128(iv[3], _mm_loadu_si128((__m128i*)&f[0]));
 
         for(int r = 0; r < 12; r++)
             Round(r, block_ptr, row1l, row2l, row3l, row4l, row1h, row2h, row3h, row4h);
 
-        _mm_storeu_si128((__m128i*)&state__.h[0],
-                         _mm_xor_si128(_mm_loadu_si128((__m128i*)&state__.h[0]), _mm_xor_si128(row3l, row1l)));
-        _mm_storeu_si128((__m128i*)&state__.h[2],
-                         _mm_xor_si128(_mm_loadu_si128((__m128i*)&state__.h[2]), _mm_xor_si128(row3h, row1h)));
-        _mm_storeu_si128((__m128i*)&state__.h[4],
-                         _mm_xor_si128(_mm_loadu_si128((__m128i*)&state__.h[4]), _mm_xor_si128(row4l, row2l)));
-        _mm_storeu_si128((__m128i*)&state__.h[6],
-                         _mm_xor_si128(_mm_loadu_si128((__m128i*)&state__.h[6]), _mm_xor_si128(row4h, row2h)));
+        _mm_storeu_si128((__m128i*)&h[0],
+                         _mm_xor_si128(_mm_loadu_si128((__m128i*)&h[0]), _mm_xor_si128(row3l, row1l)));
+        _mm_storeu_si128((__m128i*)&h[2],
+                         _mm_xor_si128(_mm_loadu_si128((__m128i*)&h[2]), _mm_xor_si128(row3h, row1h)));
+        _mm_storeu_si128((__m128i*)&h[4],
+                         _mm_xor_si128(_mm_loadu_si128((__m128i*)&h[4]), _mm_xor_si128(row4l, row2l)));
+        _mm_storeu_si128((__m128i*)&h[6],
+                         _mm_xor_si128(_mm_loadu_si128((__m128i*)&h[6]), _mm_xor_si128(row4h, row2h)));
     }
 }
@@ -118,7 +118,8 @@ namespace argonishche {
     }
 
     template<>
-    void Blake2B<InstructionSet::SSE41>::compress__(const uint8_t block[BLAKE2B_BLOCKBYTES]) {
+    inline __attribute__((always_inline)) void Blake2B<InstructionSet::SSE41>::compress__(
+            uint64_t h[8], const uint64_t t[2], const uint64_t f[2], const uint8_t block[BLAKE2B_BLOCKBYTES]) {
         static const __m128i* iv = get_iv();
 
         const __m128i* block_ptr = (__m128i*)block;
@@ -131,14 +132,14 @@ namespace argonishche {
         const __m128i m6 = _mm_loadu_si128(block_ptr + 6);
         const __m128i m7 = _mm_loadu_si128(block_ptr + 7);
 
-        __m128i row1l = _mm_loadu_si128((__m128i*)&state__.h[0]);
-        __m128i row1h = _mm_loadu_si128((__m128i*)&state__.h[2]);
-        __m128i row2l = _mm_loadu_si128((__m128i*)&state__.h[4]);
-        __m128i row2h = _mm_loadu_si128((__m128i*)&state__.h[6]);
+        __m128i row1l = _mm_loadu_si128((__m128i*)&h[0]);
+        __m128i row1h = _mm_loadu_si128((__m128i*)&h[2]);
+        __m128i row2l = _mm_loadu_si128((__m128i*)&h[4]);
+        __m128i row2h = _mm_loadu_si128((__m128i*)&h[6]);
         __m128i row3l = iv[0];
         __m128i row3h = iv[1];
-        __m128i row4l = _mm_xor_si128(iv[2], _mm_loadu_si128((__m128i*)&state__.t[0]));
-        __m128i row4h = _mm_xor_si128(iv[3], _mm_loadu_si128((__m128i*)&state__.f[0]));
+        __m128i row4l = _mm_xor_si128(iv[2], _mm_loadu_si128((__m128i*)&t[0]));
+        __m128i row4h = _mm_xor_si128(iv[3], _mm_loadu_si128((__m128i*)&f[0]));
         __m128i b0, b1;
 
         ROUND(0);
@@ -154,14 +155,14 @@ namespace argonishche {
         ROUND(10);
         ROUND(11);
 
-        _mm_storeu_si128((__m128i*)&state__.h[0],
-                         _mm_xor_si128(_mm_loadu_si128((__m128i*)&state__.h[0]), _mm_xor_si128(row3l, row1l)));
-        _mm_storeu_si128((__m128i*)&state__.h[2],
-                         _mm_xor_si128(_mm_loadu_si128((__m128i*)&state__.h[2]), _mm_xor_si128(row3h, row1h)));
-        _mm_storeu_si128((__m128i*)&state__.h[4],
-                         _mm_xor_si128(_mm_loadu_si128((__m128i*)&state__.h[4]), _mm_xor_si128(row4l, row2l)));
-        _mm_storeu_si128((__m128i*)&state__.h[6],
-                         _mm_xor_si128(_mm_loadu_si128((__m128i*)&state__.h[6]), _mm_xor_si128(row4h, row2h)));
+        _mm_storeu_si128((__m128i*)&h[0],
+                         _mm_xor_si128(_mm_loadu_si128((__m128i*)&h[0]), _mm_xor_si128(row3l, row1l)));
+        _mm_storeu_si128((__m128i*)&h[2],
+                         _mm_xor_si128(_mm_loadu_si128((__m128i*)&h[2]), _mm_xor_si128(row3h, row1h)));
+        _mm_storeu_si128((__m128i*)&h[4],
+                         _mm_xor_si128(_mm_loadu_si128((__m128i*)&h[4]), _mm_xor_si128(row4l, row2l)));
+        _mm_storeu_si128((__m128i*)&h[6],
+                         _mm_xor_si128(_mm_loadu_si128((__m128i*)&h[6]), _mm_xor_si128(row4h, row2h)));
     }
 
 #undef ROUND
@@ -0,0 +1,442 @@
+/*
+   AVX2 message loads for Blake2B, derived from the SSE4.1 ones in load_sse41.h.
+   Every 128-bit message word pair m0..m7 is broadcast to both halves of a register,
+   so the SSE4.1 in-lane operations produce the same pair in both halves and
+   vpblendd takes lanes 0-1 from the first result and lanes 2-3 from the second one.
+*/
+
+#ifndef ARGON2_LOADAVX2_H_H
+#define ARGON2_LOADAVX2_H_H
+
+#define LOAD_MSG_AVX2_0_1(b) \
+do \
+{ \
+t0 = _mm256_unpacklo_epi64(m0, m1); \
+t1 = _mm256_unpacklo_epi64(m2, m3); \
+b = _mm256_blend_epi32(t0, t1, 0xF0); \
+} while(0)
+
+
+#define LOAD_MSG_AVX2_0_2(b) \
+do \
+{ \
+t0 = _mm256_unpackhi_epi64(m0, m1); \
+t1 = _mm256_unpackhi_epi64(m2, m3); \
+b = _mm256_blend_epi32(t0, t1, 0xF0); \
+} while(0)
+
+
+#define LOAD_MSG_AVX2_0_3(b) \
+do \
+{ \
+t0 = _mm256_unpacklo_epi64(m4, m5); \
+t1 = _mm256_unpacklo_epi64(m6, m7); \
+b = _mm256_blend_epi32(t0, t1, 0xF0); \
+} while(0)
+
+
+#define LOAD_MSG_AVX2_0_4(b) \
+do \
+{ \
+t0 = _mm256_unpackhi_epi64(m4, m5); \
+t1 = _mm256_unpackhi_epi64(m6, m7); \
+b = _mm256_blend_epi32(t0, t1, 0xF0); \
+} while(0)
+
+
+#define LOAD_MSG_AVX2_1_1(b) \
+do \
+{ \
+t0 = _mm256_unpacklo_epi64(m7, m2); \
+t1 = _mm256_unpackhi_epi64(m4, m6); \
+b = _mm256_blend_epi32(t0, t1, 0xF0); \
+} while(0)
+
+
+#define LOAD_MSG_AVX2_1_2(b) \
+do \
+{ \
+t0 = _mm256_unpacklo_epi64(m5, m4); \
+t1 = _mm256_alignr_epi8(m3, m7, 8); \
+b = _mm256_blend_epi32(t0, t1, 0xF0); \
+} while(0)
+
+
+#define LOAD_MSG_AVX2_1_3(b) \
+do \
+{ \
+t0 = _mm256_shuffle_epi32(m0, _MM_SHUFFLE(1,0,3,2)); \
+t1 = _mm256_unpackhi_epi64(m5, m2); \
+b = _mm256_blend_epi32(t0, t1, 0xF0); \
+} while(0)
+
+
+#define LOAD_MSG_AVX2_1_4(b) \
+do \
+{ \
+t0 = _mm256_unpacklo_epi64(m6, m1); \
+t1 = _mm256_unpackhi_epi64(m3, m1); \
+b = _mm256_blend_epi32(t0, t1, 0xF0); \
+} while(0)
+
+
+#define LOAD_MSG_AVX2_2_1(b) \
+do \
+{ \
+t0 = _mm256_alignr_epi8(m6, m5, 8); \
+t1 = _mm256_unpackhi_epi64(m2, m7); \
+b = _mm256_blend_epi32(t0, t1, 0xF0); \
+} while(0)
+
+
+#define LOAD_MSG_AVX2_2_2(b) \
+do \
+{ \
+t0 = _mm256_unpacklo_epi64(m4, m0); \
+t1 = _mm256_blend_epi16(m1, m6, 0xF0); \
+b = _mm256_blend_epi32(t0, t1, 0xF0); \
+} while(0)
+
+
+#define LOAD_MSG_AVX2_2_3(b) \
+do \
+{ \
+t0 = _mm256_blend_epi16(m5, m1, 0xF0); \
+t1 = _mm256_unpackhi_epi64(m3, m4); \
+b = _mm256_blend_epi32(t0, t1, 0xF0); \
+} while(0)
+
+
+#define LOAD_MSG_AVX2_2_4(b) \
+do \
+{ \
+t0 = _mm256_unpacklo_epi64(m7, m3); \
+t1 = _mm256_alignr_epi8(m2, m0, 8); \
+b = _mm256_blend_epi32(t0, t1, 0xF0); \
+} while(0)
+
+
+#define LOAD_MSG_AVX2_3_1(b) \
+do \
+{ \
+t0 = _mm256_unpackhi_epi64(m3, m1); \
+t1 = _mm256_unpackhi_epi64(m6, m5); \
+b = _mm256_blend_epi32(t0, t1, 0xF0); \
+} while(0)
+
+
+#define LOAD_MSG_AVX2_3_2(b) \
+do \
+{ \
+t0 = _mm256_unpackhi_epi64(m4, m0); \
+t1 = _mm256_unpacklo_epi64(m6, m7); \
+b = _mm256_blend_epi32(t0, t1, 0xF0); \
+} while(0)
+
+
+#define LOAD_MSG_AVX2_3_3(b) \
+do \
+{ \
+t0 = _mm256_blend_epi16(m1, m2, 0xF0); \
+t1 = _mm256_blend_epi16(m2, m7, 0xF0); \
+b = _mm256_blend_epi32(t0, t1, 0xF0); \
+} while(0)
+
+
+#define LOAD_MSG_AVX2_3_4(b) \
+do \
+{ \
+t0 = _mm256_unpacklo_epi64(m3, m5); \
+t1 = _mm256_unpacklo_epi64(m0, m4); \
+b = _mm256_blend_epi32(t0, t1, 0xF0); \
+} while(0)
+
+
+#define LOAD_MSG_AVX2_4_1(b) \
+do \
+{ \
+t0 = _mm256_unpackhi_epi64(m4, m2); \
+t1 = _mm256_unpacklo_epi64(m1, m5); \
+b = _mm256_blend_epi32(t0, t1, 0xF0); \
+} while(0)
+
+
+#define LOAD_MSG_AVX2_4_2(b) \
+do \
+{ \
+t0 = _mm256_blend_epi16(m0, m3, 0xF0); \
+t1 = _mm256_blend_epi16(m2, m7, 0xF0); \
+b = _mm256_blend_epi32(t0, t1, 0xF0); \
+} while(0)
+
+
+#define LOAD_MSG_AVX2_4_3(b) \
+do \
+{ \
+t0 = _mm256_blend_epi16(m7, m5, 0xF0); \
+t1 = _mm256_blend_epi16(m3, m1, 0xF0); \
+b = _mm256_blend_epi32(t0, t1, 0xF0); \
+} while(0)
+
+
+#define LOAD_MSG_AVX2_4_4(b) \
+do \
+{ \
+t0 = _mm256_alignr_epi8(m6, m0, 8); \
+t1 = _mm256_blend_epi16(m4, m6, 0xF0); \
+b = _mm256_blend_epi32(t0, t1, 0xF0); \
+} while(0)
+
+
+#define LOAD_MSG_AVX2_5_1(b) \
+do \
+{ \
+t0 = _mm256_unpacklo_epi64(m1, m3); \
+t1 = _mm256_unpacklo_epi64(m0, m4); \
+b = _mm256_blend_epi32(t0, t1, 0xF0); \
+} while(0)
+
+
+#define LOAD_MSG_AVX2_5_2(b) \
+do \
+{ \
+t0 = _mm256_unpacklo_epi64(m6, m5); \
+t1 = _mm256_unpackhi_epi64(m5, m1); \
+b = _mm256_blend_epi32(t0, t1, 0xF0); \
+} while(0)
+
+
+#define LOAD_MSG_AVX2_5_3(b) \
+do \
+{ \
+t0 = _mm256_blend_epi16(m2, m3, 0xF0); \
+t1 = _mm256_unpackhi_epi64(m7, m0); \
+b = _mm256_blend_epi32(t0, t1, 0xF0); \
+} while(0)
+
+
+#define LOAD_MSG_AVX2_5_4(b) \
+do \
+{ \
+t0 = _mm256_unpackhi_epi64(m6, m2); \
+t1 = _mm256_blend_epi16(m7, m4, 0xF0); \
+b = _mm256_blend_epi32(t0, t1, 0xF0); \
+} while(0)
+
+
+#define LOAD_MSG_AVX2_6_1(b) \
+do \
+{ \
+t0 = _mm256_blend_epi16(m6, m0, 0xF0); \
+t1 = _mm256_unpacklo_epi64(m7, m2); \
+b = _mm256_blend_epi32(t0, t1, 0xF0); \
+} while(0)
+
+
+#define LOAD_MSG_AVX2_6_2(b) \
+do \
+{ \
+t0 = _mm256_unpackhi_epi64(m2, m7); \
+t1 = _mm256_alignr_epi8(m5, m6, 8); \
+b = _mm256_blend_epi32(t0, t1, 0xF0); \
+} while(0)
+
+
+#define LOAD_MSG_AVX2_6_3(b) \
+do \
+{ \
+t0 = _mm256_unpacklo_epi64(m0, m3); \
+t1 = _mm256_shuffle_epi32(m4, _MM_SHUFFLE(1,0,3,2)); \
+b = _mm256_blend_epi32(t0, t1, 0xF0); \
+} while(0)
+
+
+#define LOAD_MSG_AVX2_6_4(b) \
+do \
+{ \
+t0 = _mm256_unpackhi_epi64(m3, m1); \
+t1 = _mm256_blend_epi16(m1, m5, 0xF0); \
+b = _mm256_blend_epi32(t0, t1, 0xF0); \
+} while(0)
+
+
+#define LOAD_MSG_AVX2_7_1(b) \
+do \
+{ \
+t0 = _mm256_unpackhi_epi64(m6, m3); \
+t1 = _mm256_blend_epi16(m6, m1, 0xF0); \
+b = _mm256_blend_epi32(t0, t1, 0xF0); \
+} while(0)
+
+
+#define LOAD_MSG_AVX2_7_2(b) \
+do \
+{ \
+t0 = _mm256_alignr_epi8(m7, m5, 8); \
+t1 = _mm256_unpackhi_epi64(m0, m4); \
+b = _mm256_blend_epi32(t0, t1, 0xF0); \
+} while(0)
+
+
+#define LOAD_MSG_AVX2_7_3(b) \
+do \
+{ \
+t0 = _mm256_unpackhi_epi64(m2, m7); \
+t1 = _mm256_unpacklo_epi64(m4, m1); \
+b = _mm256_blend_epi32(t0, t1, 0xF0); \
+} while(0)
+
+
+#define LOAD_MSG_AVX2_7_4(b) \
+do \
+{ \
+t0 = _mm256_unpacklo_epi64(m0, m2); \
+t1 = _mm256_unpacklo_epi64(m3, m5); \
+b = _mm256_blend_epi32(t0, t1, 0xF0); \
+} while(0)
+
+
+#define LOAD_MSG_AVX2_8_1(b) \
+do \
+{ \
+t0 = _mm256_unpacklo_epi64(m3, m7); \
+t1 = _mm256_alignr_epi8(m0, m5, 8); \
+b = _mm256_blend_epi32(t0, t1, 0xF0); \
+} while(0)
+
+
+#define LOAD_MSG_AVX2_8_2(b) \
+do \
+{ \
+t0 = _mm256_unpackhi_epi64(m7, m4); \
+t1 = _mm256_alignr_epi8(m4, m1, 8); \
+b = _mm256_blend_epi32(t0, t1, 0xF0); \
+} while(0)
+
+
+#define LOAD_MSG_AVX2_8_3(b) \
+do \
+{ \
+t0 = m6; \
+t1 = _mm256_alignr_epi8(m5, m0, 8); \
+b = _mm256_blend_epi32(t0, t1, 0xF0); \
+} while(0)
+
+
+#define LOAD_MSG_AVX2_8_4(b) \
+do \
+{ \
+t0 = _mm256_blend_epi16(m1, m3, 0xF0); \
+t1 = m2; \
+b = _mm256_blend_epi32(t0, t1, 0xF0); \
+} while(0)
+
+
+#define LOAD_MSG_AVX2_9_1(b) \
+do \
+{ \
+t0 = _mm256_unpacklo_epi64(m5, m4); \
+t1 = _mm256_unpackhi_epi64(m3, m0); \
+b = _mm256_blend_epi32(t0, t1, 0xF0); \
+} while(0)
+
+
+#define LOAD_MSG_AVX2_9_2(b) \
+do \
+{ \
+t0 = _mm256_unpacklo_epi64(m1, m2); \
+t1 = _mm256_blend_epi16(m3, m2, 0xF0); \
+b = _mm256_blend_epi32(t0, t1, 0xF0); \
+} while(0)
+
+
+#define LOAD_MSG_AVX2_9_3(b) \
+do \
+{ \
+t0 = _mm256_unpackhi_epi64(m7, m4); \
+t1 = _mm256_unpackhi_epi64(m1, m6); \
+b = _mm256_blend_epi32(t0, t1, 0xF0); \
+} while(0)
+
+
+#define LOAD_MSG_AVX2_9_4(b) \
+do \
+{ \
+t0 = _mm256_alignr_epi8(m7, m5, 8); \
+t1 = _mm256_unpacklo_epi64(m6, m0); \
+b = _mm256_blend_epi32(t0, t1, 0xF0); \
+} while(0)
+
+
+#define LOAD_MSG_AVX2_10_1(b) \
+do \
+{ \
+t0 = _mm256_unpacklo_epi64(m0, m1); \
+t1 = _mm256_unpacklo_epi64(m2, m3); \
+b = _mm256_blend_epi32(t0, t1, 0xF0); \
+} while(0)
+
+
+#define LOAD_MSG_AVX2_10_2(b) \
+do \
+{ \
+t0 = _mm256_unpackhi_epi64(m0, m1); \
+t1 = _mm256_unpackhi_epi64(m2, m3); \
+b = _mm256_blend_epi32(t0, t1, 0xF0); \
+} while(0)
+
+
+#define LOAD_MSG_AVX2_10_3(b) \
+do \
+{ \
+t0 = _mm256_unpacklo_epi64(m4, m5); \
+t1 = _mm256_unpacklo_epi64(m6, m7); \
+b = _mm256_blend_epi32(t0, t1, 0xF0); \
+} while(0)
+
+
+#define LOAD_MSG_AVX2_10_4(b) \
+do \
+{ \
+t0 = _mm256_unpackhi_epi64(m4, m5); \
+t1 = _mm256_unpackhi_epi64(m6, m7); \
+b = _mm256_blend_epi32(t0, t1, 0xF0); \
+} while(0)
+
+
+#define LOAD_MSG_AVX2_11_1(b) \
+do \
+{ \
+t0 = _mm256_unpacklo_epi64(m7, m2); \
+t1 = _mm256_unpackhi_epi64(m4, m6); \
+b = _mm256_blend_epi32(t0, t1, 0xF0); \
+} while(0)
+
+
+#define LOAD_MSG_AVX2_11_2(b) \
+do \
+{ \
+t0 = _mm256_unpacklo_epi64(m5, m4); \
+t1 = _mm256_alignr_epi8(m3, m7, 8); \
+b = _mm256_blend_epi32(t0, t1, 0xF0); \
+} while(0)
+
+
+#define LOAD_MSG_AVX2_11_3(b) \
+do \
+{ \
+t0 = _mm256_shuffle_epi32(m0, _MM_SHUFFLE(1,0,3,2)); \
+t1 = _mm256_unpackhi_epi64(m5, m2); \
+b = _mm256_blend_epi32(t0, t1, 0xF0); \
+} while(0)
+
+
+#define LOAD_MSG_AVX2_11_4(b) \
+do \
+{ \
+t0 = _mm256_unpacklo_epi64(m6, m1); \
+t1 = _mm256_unpackhi_epi64(m3, m1); \
+b = _mm256_blend_epi32(t0, t1, 0xF0); \
+} while(0)
+
+#endif //ARGON2_LOADAVX2_H_H
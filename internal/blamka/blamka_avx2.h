@@ -5,7 +5,7 @@
 
 namespace argonishche {
 
-    static inline void BLAMKA_G1_AVX2(
+    static inline __attribute__((always_inline)) void BLAMKA_G1_AVX2(
             __m256i& a0, __m256i& a1, __m256i& b0, __m256i& b1,
             __m256i& c0, __m256i& c1, __m256i& d0, __m256i& d1
     ) {
@@ -36,7 +36,7 @@ namespace argonishche {
         b1 = rotr24(b1);
     }
 
-    static inline void BLAMKA_G2_AVX2(
+    static inline __attribute__((always_inline)) void BLAMKA_G2_AVX2(
             __m256i& a0, __m256i& a1, __m256i& b0, __m256i& b1,
             __m256i& c0, __m256i& c1, __m256i& d0, __m256i& d1
     ) {
@@ -69,7 +69,7 @@ namespace argonishche {
     /* b = ( v4,  v5,  v6,  v7) */
     /* c = ( v8,  v9, v10, v11) */
     /* d = (v12, v13, v14, v15) */
-    static inline void DIAGONALIZE_AVX2_1(
+    static inline __attribute__((always_inline)) void DIAGONALIZE_AVX2_1(
             __m256i& b0, __m256i& c0, __m256i& d0, __m256i& b1, __m256i& c1, __m256i& d1
 
     ) {
@@ -85,7 +85,7 @@ namespace argonishche {
         d1 = _mm256_permute4x64_epi64(d1, _MM_SHUFFLE(2, 1, 0, 3));
     }
 
-    static inline void DIAGONALIZE_AVX2_2(
+    static inline __attribute__((always_inline)) void DIAGONALIZE_AVX2_2(
             __m256i& b0, __m256i& b1, __m256i& c0, __m256i& c1, __m256i& d0, __m256i& d1
     ) {
         /* (v4, v5, v6, v7) -> (v5, v6, v7, v4) */
@@ -106,7 +106,7 @@ namespace argonishche {
         d1 = _mm256_permute4x64_epi64(tmp2, _MM_SHUFFLE(2,3,0,1)); /* v13v14 */
     }
 
-    static inline void UNDIAGONALIZE_AVX2_1(
+    static inline __attribute__((always_inline)) void UNDIAGONALIZE_AVX2_1(
             __m256i& b0, __m256i& c0, __m256i& d0, __m256i& b1, __m256i& c1, __m256i& d1
     ) {
         /* (v5, v6, v7, v4) -> (v4, v5, v6, v7) */
@@ -121,7 +121,7 @@ namespace argonishche {
         d1 = _mm256_permute4x64_epi64(d1, _MM_SHUFFLE(0, 3, 2, 1));
     }
 
-    static inline void UNDIAGONALIZE_AVX2_2(
+    static inline __attribute__((always_inline)) void UNDIAGONALIZE_AVX2_2(
             __m256i& b0, __m256i& b1, __m256i& c0, __m256i& c1, __m256i& d0, __m256i& d1
     ) {
         /* (v5, v6, v7, v4) -> (v4, v5, v6, v7) */
@@ -141,4 +141,41 @@ namespace argonishche {
         d0 = _mm256_permute4x64_epi64(tmp1, _MM_SHUFFLE(2,3,0,1));
         d1 = _mm256_permute4x64_epi64(tmp2, _MM_SHUFFLE(2,3,0,1));
     }
+
+    /*
+     * Versions for interleaved blocks of several hashes (see Argon2::fill_block_batch__).
+     * Every register holds the same qword of 4 hashes, so the permutation needs no shuffles
+     */
+    static inline __attribute__((always_inline)) __m256i FBLAMKA_BATCH_AVX2(__m256i x, __m256i y) {
+        __m256i ml = _mm256_mul_epu32(x, y);
+        ml = _mm256_add_epi64(ml, ml);
+        return _mm256_add_epi64(x, _mm256_add_epi64(y, ml));
+    }
+
+    static inline __attribute__((always_inline)) void BLAMKA_G_BATCH_AVX2(__m256i& a, __m256i& b, __m256i& c, __m256i& d) {
+        a = FBLAMKA_BATCH_AVX2(a, b);
+        d = rotr32(_mm256_xor_si256(d, a));
+        c = FBLAMKA_BATCH_AVX2(c, d);
+        b = rotr24(_mm256_xor_si256(b, c));
+        a = FBLAMKA_BATCH_AVX2(a, b);
+        d = rotr16(_mm256_xor_si256(d, a));
+        c = FBLAMKA_BATCH_AVX2(c, d);
+        b = rotr63(_mm256_xor_si256(b, c));
+    }
+
+    static inline __attribute__((always_inline)) void BLAMKA_ROUND_BATCH_AVX2(
+            __m256i&  v0, __m256i&  v1, __m256i&  v2, __m256i&  v3,
+            __m256i&  v4, __m256i&  v5, __m256i&  v6, __m256i&  v7,
+            __m256i&  v8, __m256i&  v9, __m256i& v10, __m256i& v11,
+            __m256i& v12, __m256i& v13, __m256i& v14, __m256i& v15
+    ) {
+        BLAMKA_G_BATCH_AVX2(v0, v4,  v8, v12);
+        BLAMKA_G_BATCH_AVX2(v1, v5,  v9, v13);
+        BLAMKA_G_BATCH_AVX2(v2, v6, v10, v14);
+        BLAMKA_G_BATCH_AVX2(v3, v7, v11, v15);
+        BLAMKA_G_BATCH_AVX2(v0, v5, v10, v15);
+        BLAMKA_G_BATCH_AVX2(v1, v6, v11, v12);
+        BLAMKA_G_BATCH_AVX2(v2, v7,  v8, v13);
+        BLAMKA_G_BATCH_AVX2(v3, v4,  v9, v14);
+    }
 }
@@ -0,0 +1,186 @@
+#pragma once
+
+#include <immintrin.h>
+#include "internal/rotations/rotations_avx512.h"
+
+namespace argonishche {
+
+    static inline __attribute__((always_inline)) __m512i FBLAMKA_AVX512(__m512i x, __m512i y) {
+        __m512i ml = _mm512_mul_epu32(x, y);
+        ml = _mm512_add_epi64(ml, ml);
+        return _mm512_add_epi64(x, _mm512_add_epi64(y, ml));
+    }
+
+    static inline __attribute__((always_inline)) void BLAMKA_G1_AVX512(
+            __m512i& a0, __m512i& b0, __m512i& c0, __m512i& d0,
+            __m512i& a1, __m512i& b1, __m512i& c1, __m512i& d1
+    ) {
+        a0 = FBLAMKA_AVX512(a0, b0);
+        a1 = FBLAMKA_AVX512(a1, b1);
+
+        d0 = rotr32(_mm512_xor_si512(d0, a0));
+        d1 = rotr32(_mm512_xor_si512(d1, a1));
+
+        c0 = FBLAMKA_AVX512(c0, d0);
+        c1 = FBLAMKA_AVX512(c1, d1);
+
+        b0 = rotr24(_mm512_xor_si512(b0, c0));
+        b1 = rotr24(_mm512_xor_si512(b1, c1));
+    }
+
+    static inline __attribute__((always_inline)) void BLAMKA_G2_AVX512(
+            __m512i& a0, __m512i& b0, __m512i& c0, __m512i& d0,
+            __m512i& a1, __m512i& b1, __m512i& c1, __m512i& d1
+    ) {
+        a0 = FBLAMKA_AVX512(a0, b0);
+        a1 = FBLAMKA_AVX512(a1, b1);
+
+        d0 = rotr16(_mm512_xor_si512(d0, a0));
+        d1 = rotr16(_mm512_xor_si512(d1, a1));
+
+        c0 = FBLAMKA_AVX512(c0, d0);
+        c1 = FBLAMKA_AVX512(c1, d1);
+
+        b0 = rotr63(_mm512_xor_si512(b0, c0));
+        b1 = rotr63(_mm512_xor_si512(b1, c1));
+    }
+
+    /*
+     * Every 256-bit half of a register holds a separate row:
+     * a = ( v0,  v1,  v2,  v3 | ... )
+     * b = ( v4,  v5,  v6,  v7 | ... )
+     * c = ( v8,  v9, v10, v11 | ... )
+     * d = (v12, v13, v14, v15 | ... )
+     */
+    static inline __attribute__((always_inline)) void DIAGONALIZE_AVX512(
+            __m512i& b0, __m512i& c0, __m512i& d0, __m512i& b1, __m512i& c1, __m512i& d1
+    ) {
+        /* (v4, v5, v6, v7) -> (v5, v6, v7, v4) */
+        b0 = _mm512_permutex_epi64(b0, _MM_SHUFFLE(0, 3, 2, 1));
+        b1 = _mm512_permutex_epi64(b1, _MM_SHUFFLE(0, 3, 2, 1));
+        /* (v8, v9, v10, v11) -> (v10, v11, v8, v9) */
+        c0 = _mm512_permutex_epi64(c0, _MM_SHUFFLE(1, 0, 3, 2));
+        c1 = _mm512_permutex_epi64(c1, _MM_SHUFFLE(1, 0, 3, 2));
+        /* (v12, v13, v14, v15) -> (v15, v12, v13, v14) */
+        d0 = _mm512_permutex_epi64(d0, _MM_SHUFFLE(2, 1, 0, 3));
+        d1 = _mm512_permutex_epi64(d1, _MM_SHUFFLE(2, 1, 0, 3));
+    }
+
+    static inline __attribute__((always_inline)) void UNDIAGONALIZE_AVX512(
+            __m512i& b0, __m512i& c0, __m512i& d0, __m512i& b1, __m512i& c1, __m512i& d1
+    ) {
+        /* (v5, v6, v7, v4) -> (v4, v5, v6, v7) */
+        b0 = _mm512_permutex_epi64(b0, _MM_SHUFFLE(2, 1, 0, 3));
+        b1 = _mm512_permutex_epi64(b1, _MM_SHUFFLE(2, 1, 0, 3));
+        /* (v10, v11, v8, v9) -> (v8, v9, v10, v11) */
+        c0 = _mm512_permutex_epi64(c0, _MM_SHUFFLE(1, 0, 3, 2));
+        c1 = _mm512_permutex_epi64(c1, _MM_SHUFFLE(1, 0, 3, 2));
+        /* (v15, v12, v13, v14) -> (v12, v13, v14, v15) */
+        d0 = _mm512_permutex_epi64(d0, _MM_SHUFFLE(0, 3, 2, 1));
+        d1 = _mm512_permutex_epi64(d1, _MM_SHUFFLE(0, 3, 2, 1));
+    }
+
+    static inline __attribute__((always_inline)) void BLAMKA_ROUND_AVX512(
+            __m512i& a0, __m512i& b0, __m512i& c0, __m512i& d0,
+            __m512i& a1, __m512i& b1, __m512i& c1, __m512i& d1
+    ) {
+        BLAMKA_G1_AVX512(a0, b0, c0, d0, a1, b1, c1, d1);
+        BLAMKA_G2_AVX512(a0, b0, c0, d0, a1, b1, c1, d1);
+        DIAGONALIZE_AVX512(b0, c0, d0, b1, c1, d1);
+        BLAMKA_G1_AVX512(a0, b0, c0, d0, a1, b1, c1, d1);
+        BLAMKA_G2_AVX512(a0, b0, c0, d0, a1, b1, c1, d1);
+        UNDIAGONALIZE_AVX512(b0, c0, d0, b1, c1, d1);
+    }
+
+    /* (x0, x1 | x2, x3), (y0, y1 | y2, y3) -> (x0, x1 | y0, y1), (x2, x3 | y2, y3) */
+    static inline __attribute__((always_inline)) void SWAP_HALVES_AVX512(__m512i& x, __m512i& y) {
+        __m512i t0 = _mm512_shuffle_i64x2(x, y, _MM_SHUFFLE(1, 0, 1, 0));
+        __m512i t1 = _mm512_shuffle_i64x2(x, y, _MM_SHUFFLE(3, 2, 3, 2));
+        x = t0;
+        y = t1;
+    }
+
+    /* (x0, x1, x2, x3), (y0, y1, y2, y3) -> (x0, y0, x1, y1), (x2, y2, x3, y3) where xi, yi are 128-bit words */
+    static inline __attribute__((always_inline)) void SWAP_QUARTERS_AVX512(__m512i& x, __m512i& y) {
+        const __m512i idx = _mm512_setr_epi64(0, 1, 4, 5, 2, 3, 6, 7);
+        SWAP_HALVES_AVX512(x, y);
+        x = _mm512_permutexvar_epi64(idx, x);
+        y = _mm512_permutexvar_epi64(idx, y);
+    }
+
+    static inline __attribute__((always_inline)) void UNSWAP_QUARTERS_AVX512(__m512i& x, __m512i& y) {
+        const __m512i idx = _mm512_setr_epi64(0, 1, 4, 5, 2, 3, 6, 7);
+        x = _mm512_permutexvar_epi64(idx, x);
+        y = _mm512_permutexvar_epi64(idx, y);
+        SWAP_HALVES_AVX512(x, y);
+    }
+
+    /*
+     * Applies the Blamka permutation to two pairs of rows.
+     * Each row is 16 qwords long and occupies two registers: (r0l, r0h), (r1l, r1h) etc.
+     */
+    static inline __attribute__((always_inline)) void BLAMKA_ROUND_ROWS_AVX512(
+            __m512i& r0l, __m512i& r0h, __m512i& r1l, __m512i& r1h,
+            __m512i& r2l, __m512i& r2h, __m512i& r3l, __m512i& r3h
+    ) {
+        SWAP_HALVES_AVX512(r0l, r1l);
+        SWAP_HALVES_AVX512(r0h, r1h);
+        SWAP_HALVES_AVX512(r2l, r3l);
+        SWAP_HALVES_AVX512(r2h, r3h);
+        BLAMKA_ROUND_AVX512(r0l, r1l, r0h, r1h, r2l, r3l, r2h, r3h);
+        SWAP_HALVES_AVX512(r0l, r1l);
+        SWAP_HALVES_AVX512(r0h, r1h);
+        SWAP_HALVES_AVX512(r2l, r3l);
+        SWAP_HALVES_AVX512(r2h, r3h);
+    }
+
+    /*
+     * Applies the Blamka permutation to four columns.
+     * The arguments are the same halves (either low or high) of rows 0..7
+     */
+    static inline __attribute__((always_inline)) void BLAMKA_ROUND_COLUMNS_AVX512(
+            __m512i& r0, __m512i& r1, __m512i& r2, __m512i& r3,
+            __m512i& r4, __m512i& r5, __m512i& r6, __m512i& r7
+    ) {
+        SWAP_QUARTERS_AVX512(r0, r1);
+        SWAP_QUARTERS_AVX512(r2, r3);
+        SWAP_QUARTERS_AVX512(r4, r5);
+        SWAP_QUARTERS_AVX512(r6, r7);
+        BLAMKA_ROUND_AVX512(r0, r2, r4, r6, r1, r3, r5, r7);
+        UNSWAP_QUARTERS_AVX512(r0, r1);
+        UNSWAP_QUARTERS_AVX512(r2, r3);
+        UNSWAP_QUARTERS_AVX512(r4, r5);
+        UNSWAP_QUARTERS_AVX512(r6, r7);
+    }
+
+    /*
+     * Versions for interleaved blocks of several hashes (see Argon2::fill_block_batch__).
+     * Every register holds the same qword of 8 hashes, so the permutation needs no shuffles
+     */
+    static inline __attribute__((always_inline)) void BLAMKA_G_BATCH_AVX512(__m512i& a, __m512i& b, __m512i& c, __m512i& d) {
+        a = FBLAMKA_AVX512(a, b);
+        d = rotr32(_mm512_xor_si512(d, a));
+        c = FBLAMKA_AVX512(c, d);
+        b = rotr24(_mm512_xor_si512(b, c));
+        a = FBLAMKA_AVX512(a, b);
+        d = rotr16(_mm512_xor_si512(d, a));
+        c = FBLAMKA_AVX512(c, d);
+        b = rotr63(_mm512_xor_si512(b, c));
+    }
+
+    static inline __attribute__((always_inline)) void BLAMKA_ROUND_BATCH_AVX512(
+            __m512i&  v0, __m512i&  v1, __m512i&  v2, __m512i&  v3,
+            __m512i&  v4, __m512i&  v5, __m512i&  v6, __m512i&  v7,
+            __m512i&  v8, __m512i&  v9, __m512i& v10, __m512i& v11,
+            __m512i& v12, __m512i& v13, __m512i& v14, __m512i& v15
+    ) {
+        BLAMKA_G_BATCH_AVX512(v0, v4,  v8, v12);
+        BLAMKA_G_BATCH_AVX512(v1, v5,  v9, v13);
+        BLAMKA_G_BATCH_AVX512(v2, v6, v10, v14);
+        BLAMKA_G_BATCH_AVX512(v3, v7, v11, v15);
+        BLAMKA_G_BATCH_AVX512(v0, v5, v10, v15);
+        BLAMKA_G_BATCH_AVX512(v1, v6, v11, v12);
+        BLAMKA_G_BATCH_AVX512(v2, v7,  v8, v13);
+        BLAMKA_G_BATCH_AVX512(v3, v4,  v9, v14);
+    }
+}
@@ -4,7 +4,7 @@
 
 namespace argonishche {
 
-    static inline void BLAMKA_G1_SSE2(
+    static inline __attribute__((always_inline)) void BLAMKA_G1_SSE2(
             __m128i& a0, __m128i& a1, __m128i& b0, __m128i& b1,
             __m128i& c0, __m128i& c1, __m128i& d0, __m128i& d1
     )
@@ -38,7 +38,7 @@ namespace argonishche {
         b1 = rotr24(b1);
     }
 
-    static inline void BLAMKA_G2_SSE2(
+    static inline __attribute__((always_inline)) void BLAMKA_G2_SSE2(
             __m128i& a0, __m128i& a1, __m128i& b0, __m128i& b1,
             __m128i& c0, __m128i& c1, __m128i& d0, __m128i& d1
     )
@@ -72,7 +72,7 @@ namespace argonishche {
         b1 = rotr63(b1);
     }
 
-    static inline void DIAGONALIZE_SSE2(
+    static inline __attribute__((always_inline)) void DIAGONALIZE_SSE2(
             __m128i& b0, __m128i& b1, __m128i& c0, __m128i& c1, __m128i& d0, __m128i& d1
     ) {
         __m128i tmp0 = d0;
@@ -86,7 +86,7 @@ namespace argonishche {
         b1 = _mm_unpackhi_epi64(b1, _mm_unpacklo_epi64(tmp1, tmp1));
     }
 
-    static inline void UNDIAGONALIZE_SSE2(
+    static inline __attribute__((always_inline)) void UNDIAGONALIZE_SSE2(
             __m128i& b0, __m128i& b1, __m128i& c0, __m128i& c1, __m128i& d0, __m128i& d1
     ) {
         __m128i tmp0 = c0;
@@ -3,7 +3,7 @@
 #include "internal/rotations/rotations_ssse3.h"
 
 namespace argonishche {
-    static inline void BLAMKA_G1_SSSE3(
+    static inline __attribute__((always_inline)) void BLAMKA_G1_SSSE3(
             __m128i& a0, __m128i& a1, __m128i& b0, __m128i& b1,
             __m128i& c0, __m128i& c1, __m128i& d0, __m128i& d1
     )
@@ -37,7 +37,7 @@ namespace argonishche {
         b1 = rotr24(b1);
     }
 
-    static inline void BLAMKA_G2_SSSE3(
+    static inline __attribute__((always_inline)) void BLAMKA_G2_SSSE3(
             __m128i& a0, __m128i& a1, __m128i& b0, __m128i& b1,
             __m128i& c0, __m128i& c1, __m128i& d0, __m128i& d1
     )
@@ -71,7 +71,7 @@ namespace argonishche {
         b1 = rotr63(b1);
     }
 
-    static inline void DIAGONALIZE_SSSE3(
+    static inline __attribute__((always_inline)) void DIAGONALIZE_SSSE3(
             __m128i& b0, __m128i& b1, __m128i& c0, __m128i& c1, __m128i& d0, __m128i& d1
     ) {
         __m128i t0 = _mm_alignr_epi8(b1, b0, 8);
@@ -89,7 +89,7 @@ namespace argonishche {
         d1 = t0;
     }
 
-    static inline void UNDIAGONALIZE_SSSE3(
+    static inline __attribute__((always_inline)) void UNDIAGONALIZE_SSSE3(
             __m128i& b0, __m128i& b1, __m128i& c0, __m128i& c1, __m128i& d0, __m128i& d1
     ) {
         __m128i t0 = _mm_alignr_epi8(b0, b1, 8);
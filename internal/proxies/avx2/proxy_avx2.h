@@ -7,5 +7,6 @@
 namespace argonishche {
     ARGON2_PROXY_CLASS_DECL(AVX2)
     BLAKE2B_PROXY_CLASS_DECL(AVX2)
+    BLAKE2B_MULTI_PROXY_CLASS_DECL(AVX2)
 }
 
@@ -0,0 +1,17 @@
+#include "proxy_avx512.h"
+#include "internal/argon2/argon2_base.h"
+#include "internal/argon2/argon2_avx512.h"
+#include "internal/blake2b/blake2b.h"
+#include "internal/blake2b/blake2b_avx512.h"
+#include "internal/blake2b/blake2b_multi.h"
+#include "internal/blake2b/blake2b_multi_avx512.h"
+
+#define ZEROUPPER _mm256_zeroupper();
+
+namespace argonishche {
+    ARGON2_PROXY_CLASS_IMPL(AVX512)
+    BLAKE2B_PROXY_CLASS_IMPL(AVX512)
+    BLAKE2B_MULTI_PROXY_CLASS_IMPL(AVX512)
+}
+
+#undef ZEROUPPER
@@ -0,0 +1,11 @@
+#pragma once
+
+#include <cstdint>
+#include "argonishche.h"
+#include "internal/proxies/proxy_macros.h"
+
+namespace argonishche {
+    ARGON2_PROXY_CLASS_DECL(AVX512)
+    BLAKE2B_PROXY_CLASS_DECL(AVX512)
+    BLAKE2B_MULTI_PROXY_CLASS_DECL(AVX512)
+}
@@ -24,14 +24,28 @@
                     const uint8_t *salt, uint32_t saltlen, const uint8_t *hash, uint32_t hashlen, \
                     const uint8_t *aad = nullptr, uint32_t aadlen = 0) const override; \
         virtual size_t GetMemorySize() const override; \
+        virtual void HashBatch(const uint8_t* const* pwd, const uint32_t* pwdlen, \
+                    const uint8_t* const* salt, const uint32_t* saltlen, uint8_t* const* out, uint32_t outlen, \
+                    size_t count, const uint8_t* aad = nullptr, uint32_t aadlen = 0) const override; \
+        virtual void VerifyBatch(const uint8_t* const* pwd, const uint32_t* pwdlen, \
+                    const uint8_t* const* salt, const uint32_t* saltlen, const uint8_t* const* hash, uint32_t hashlen, \
+                    bool* result, size_t count, const uint8_t* aad = nullptr, uint32_t aadlen = 0) const override; \
+        virtual uint32_t GetBatchSize() const override; \
     protected: \
         std::unique_ptr<Argon2Base> argon2; \
     };
 
+#define ARGON2_TYPED_INSTANCE_DECL(IS_val, type_val, mcost_val, threads_val) \
+    if (atype == Argon2Type::type_val) { \
+        argon2 = std::make_unique<Argon2##IS_val<Argon2Type::type_val, mcost_val, threads_val>>(tcost, key, keylen); \
+        return; \
+    } \
+
 #define ARGON2_INSTANCE_DECL(IS_val, mcost_val, threads_val) \
     if (mcost == mcost_val && threads == threads_val) { \
-        argon2 = std::make_unique<Argon2##IS_val<mcost_val, threads_val>>(atype, tcost, key, keylen); \
-        return; \
+        ARGON2_TYPED_INSTANCE_DECL(IS_val, Argon2_d, mcost_val, threads_val) \
+        ARGON2_TYPED_INSTANCE_DECL(IS_val, Argon2_i, mcost_val, threads_val) \
+        ARGON2_TYPED_INSTANCE_DECL(IS_val, Argon2_id, mcost_val, threads_val) \
     } \
 
 #define ARGON2_PROXY_CLASS_IMPL(IS) \
@@ -139,6 +153,43 @@
     \
     size_t Argon2Proxy##IS::GetMemorySize() const { \
         return argon2->GetMemorySize(); \
+    } \
+    \
+    void Argon2Proxy##IS::HashBatch(const uint8_t* const* pwd, const uint32_t* pwdlen, \
+            const uint8_t* const* salt, const uint32_t* saltlen, uint8_t* const* out, uint32_t outlen, \
+            size_t count, const uint8_t* aad, uint32_t aadlen) const { \
+        if(count > 0 && (pwd == nullptr || pwdlen == nullptr || salt == nullptr || saltlen == nullptr || out == nullptr)) \
+            throw std::invalid_argument("batch arrays must not be null"); \
+        if(outlen < ARGON2_MIN_OUTLEN) \
+            throw std::invalid_argument("output length is too short"); \
+        for(size_t i = 0; i < count; ++i) { \
+            if(saltlen[i] < ARGON2_SALT_MIN_LEN) \
+                throw std::invalid_argument("salt is too short"); \
+        } \
+        \
+        argon2->HashBatch(pwd, pwdlen, salt, saltlen, out, outlen, count, aad, aadlen); \
+        ZEROUPPER \
+    } \
+    \
+    void Argon2Proxy##IS::VerifyBatch(const uint8_t* const* pwd, const uint32_t* pwdlen, \
+            const uint8_t* const* salt, const uint32_t* saltlen, const uint8_t* const* hash, uint32_t hashlen, \
+            bool* result, size_t count, const uint8_t* aad, uint32_t aadlen) const { \
+        if(count > 0 && (pwd == nullptr || pwdlen == nullptr || salt == nullptr || saltlen == nullptr || \
+                         hash == nullptr || result == nullptr)) \
+            throw std::invalid_argument("batch arrays must not be null"); \
+        if(hashlen < ARGON2_MIN_OUTLEN) \
+            throw std::invalid_argument("hash length is too short"); \
+        for(size_t i = 0; i < count; ++i) { \
+            if(saltlen[i] < ARGON2_SALT_MIN_LEN) \
+                throw std::invalid_argument("salt is too short"); \
+        } \
+        \
+        argon2->VerifyBatch(pwd, pwdlen, salt, saltlen, hash, hashlen, result, count, aad, aadlen); \
+        ZEROUPPER \
+    } \
+    \
+    uint32_t Argon2Proxy##IS::GetBatchSize() const { \
+        return argon2->GetBatchSize(); \
     }
 
 #define BLAKE2B_PROXY_CLASS_DECL(IS) \
@@ -182,3 +233,46 @@
         blake2->Final(out, outlen); \
         ZEROUPPER \
     }
+
+#define BLAKE2B_MULTI_PROXY_CLASS_DECL(IS) \
+    class Blake2BMultiProxy##IS final : public Blake2MultiBase { \
+    public: \
+        Blake2BMultiProxy##IS(size_t outlen, const void *key = nullptr, size_t keylen = 0); \
+        virtual void Hash(const uint8_t* const* in, const size_t* inlen, uint8_t* const* out, size_t count) const override; \
+        virtual uint32_t GetLanes() const override; \
+    protected: \
+        std::unique_ptr<Blake2MultiBase> blake2; \
+    };
+
+#define BLAKE2B_MULTI_PROXY_CLASS_IMPL(IS) \
+    Blake2BMultiProxy##IS::Blake2BMultiProxy##IS(size_t outlen, const void *key, size_t keylen) { \
+        if (!outlen || outlen > BLAKE2B_OUTBYTES) \
+            throw std::invalid_argument("outlen equals 0 or too long"); \
+        \
+        if(key == nullptr) { \
+            blake2 = std::make_unique<Blake2BMulti<InstructionSet::IS>>(outlen); \
+            return; \
+        } \
+        \
+        if(!key || !keylen || keylen > BLAKE2B_KEYBYTES) \
+            throw std::invalid_argument("key is null or too long"); \
+        \
+        blake2 = std::make_unique<Blake2BMulti<InstructionSet::IS>>(outlen, key, keylen); \
+    } \
+    \
+    void Blake2BMultiProxy##IS::Hash(const uint8_t* const* in, const size_t* inlen, uint8_t* const* out, \
+                                     size_t count) const { \
+        if (count > 0 && (in == nullptr || inlen == nullptr || out == nullptr)) \
+            throw std::invalid_argument("in, inlen or out is null"); \
+        for (size_t i = 0; i < count; ++i) { \
+            if ((in[i] == nullptr && inlen[i] > 0) || out[i] == nullptr) \
+                throw std::invalid_argument("message or output buffer is null"); \
+        } \
+        \
+        blake2->Hash(in, inlen, out, count); \
+        ZEROUPPER \
+    } \
+    \
+    uint32_t Blake2BMultiProxy##IS::GetLanes() const { \
+        return blake2->GetLanes(); \
+    }
@@ -3,6 +3,8 @@
 #include "internal/argon2/argon2_ref.h"
 #include "internal/blake2b/blake2b.h"
 #include "internal/blake2b/blake2b_ref.h"
+#include "internal/blake2b/blake2b_multi.h"
+#include "internal/blake2b/blake2b_multi_ref.h"
 
 #include <stdexcept>
 
@@ -11,6 +13,7 @@
 namespace argonishche {
     ARGON2_PROXY_CLASS_IMPL(REF)
     BLAKE2B_PROXY_CLASS_IMPL(REF)
+    BLAKE2B_MULTI_PROXY_CLASS_IMPL(REF)
 }
 
 #undef ZEROUPPER
@@ -7,4 +7,5 @@
 namespace argonishche {
     ARGON2_PROXY_CLASS_DECL(REF)
     BLAKE2B_PROXY_CLASS_DECL(REF)
+    BLAKE2B_MULTI_PROXY_CLASS_DECL(REF)
 }
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <immintrin.h>
+
+namespace argonishche {
+    static inline void xor_values(__m512i* result, const __m512i* val1, const __m512i* val2) {
+        _mm512_storeu_si512(result, _mm512_xor_si512(
+                _mm512_loadu_si512(val1), _mm512_loadu_si512(val2)
+        ));
+    }
+
+    static inline __m512i rotr32(__m512i x) {
+        return _mm512_ror_epi64(x, 32);
+    }
+
+    static inline __m512i rotr24(__m512i x) {
+        return _mm512_ror_epi64(x, 24);
+    }
+
+    static inline __m512i rotr16(__m512i x) {
+        return _mm512_ror_epi64(x, 16);
+    }
+
+    static inline __m512i rotr63(__m512i x) {
+        return _mm512_ror_epi64(x, 63);
+    }
+
+    /* AVX-512VL versions for 256-bit vectors */
+    static inline __m256i rotr32(__m256i x) {
+        return _mm256_ror_epi64(x, 32);
+    }
+
+    static inline __m256i rotr24(__m256i x) {
+        return _mm256_ror_epi64(x, 24);
+    }
+
+    static inline __m256i rotr16(__m256i x) {
+        return _mm256_ror_epi64(x, 16);
+    }
+
+    static inline __m256i rotr63(__m256i x) {
+        return _mm256_ror_epi64(x, 63);
+    }
+}
@@ -138,7 +138,7 @@ namespace argonishche {
     public: \
         static bool RunTest() { \
             uint8_t hash_val[32]; \
-            Argon2##InstructionSet<1024, 1> argon2(Argon2Type::Argon2_d, 1, nullptr, 0); \
+            Argon2##InstructionSet<Argon2Type::Argon2_d, 1024, 1> argon2(1, nullptr, 0); \
             argon2.Hash((const uint8_t*)Argon2Password, 8, Argon2Salt, 8, hash_val, 32); \
             bool rs1 = (memcmp(hash_val, Argon2dResult, 32) == 0); \
             \
@@ -156,7 +156,7 @@ namespace argonishche {
     public: \
         static bool RunTest() { \
             uint8_t hash_res[32]; \
-            Argon2##InstructionSet<mcost, threads> argon2(type, tcost, (uint8_t*)GenKatSecret, sizeof(GenKatSecret)); \
+            Argon2##InstructionSet<type, mcost, threads> argon2(tcost, (uint8_t*)GenKatSecret, sizeof(GenKatSecret)); \
             argon2.Hash( \
                 (uint8_t*)GenKatPassword, sizeof(GenKatPassword), \
                 GenKatSalt, sizeof(GenKatSalt), \
@@ -176,6 +176,56 @@ namespace argonishche {
         } \
     };
 
+#define ARGON2_BATCH_TEST(InstructionSet, type, name, tcost, mcost, threads) \
+    class Test_Argon2Batch_##InstructionSet##name { \
+    public: \
+        static bool RunTest() { \
+            const size_t count = 11; \
+            uint8_t pwd[count][16], salt[count][16], hash_res[count][32], expected[32]; \
+            const uint8_t* ppwd[count]; \
+            const uint8_t* psalt[count]; \
+            uint8_t* pout[count]; \
+            uint32_t pwdlen[count], saltlen[count]; \
+            bool results[count]; \
+            for (size_t i = 0; i < count; ++i) { \
+                memset(pwd[i], (int)i, sizeof(pwd[i])); \
+                memset(salt[i], (int)(i / 2), sizeof(salt[i])); \
+                ppwd[i] = pwd[i]; \
+                psalt[i] = salt[i]; \
+                pout[i] = hash_res[i]; \
+                pwdlen[i] = (uint32_t)(i % sizeof(pwd[i])); \
+                saltlen[i] = (uint32_t)(8 + i % 9); \
+            } \
+            Argon2##InstructionSet<type, mcost, threads> argon2(tcost, (uint8_t*)GenKatSecret, sizeof(GenKatSecret)); \
+            argon2.HashBatch(ppwd, pwdlen, psalt, saltlen, pout, 32, count, GenKatAAD, sizeof(GenKatAAD)); \
+            for (size_t i = 0; i < count; ++i) { \
+                argon2.Hash(pwd[i], pwdlen[i], salt[i], saltlen[i], expected, 32, GenKatAAD, sizeof(GenKatAAD)); \
+                if (memcmp(expected, hash_res[i], 32) != 0) \
+                    return false; \
+            } \
+            hash_res[3][0] ^= 1; \
+            argon2.VerifyBatch(ppwd, pwdlen, psalt, saltlen, pout, 32, results, count, GenKatAAD, sizeof(GenKatAAD)); \
+            for (size_t i = 0; i < count; ++i) { \
+                if (results[i] != (i != 3)) \
+                    return false; \
+            } \
+            return true; \
+        } \
+    };
+
+    /* Runs a test with one OpenMP thread, so lanes of a multi-lane hash are interleaved on a single core */
+    inline bool RunSingleThreaded(bool (*test)()) {
+#ifdef _OPENMP
+        const int threads = omp_get_max_threads();
+        omp_set_num_threads(1);
+        const bool result = test();
+        omp_set_num_threads(threads);
+        return result;
+#else
+        return test();
+#endif
+    }
+
 #define CHECK_RESULT(x) \
     if(!x) return 1;
 
@@ -0,0 +1,24 @@
+#include <cstdint>
+#include <iostream>
+
+#include "argonishche.h"
+#include "internal/blake2b/blake2b.h"
+#include "internal/blake2b/blake2b_avx512.h"
+#include "internal/blake2b/blake2b_multi_avx512.h"
+#include "internal/argon2/argon2_base.h"
+#include "internal/argon2/argon2_avx512.h"
+#include "tests.h"
+
+using namespace std;
+using namespace argonishche;
+
+DECLARE_ARGON2_TESTS(AVX512)
+DECLARE_BLAKE2B_TESTS(AVX512)
+DECLARE_BLAKE2B_MULTI_TESTS(AVX512)
+
+int main(int argc, char** argv) {
+    RUN_BLAKE2B_TESTS(AVX512)
+    RUN_BLAKE2B_MULTI_TESTS(AVX512)
+    RUN_ARGON2_TESTS(AVX512)
+    return 0;
+}
@@ -2,6 +2,7 @@
 
 #include <cstdint>
 #include <iomanip>
+#include <memory>
 #include "argonishche.h"
 #include "internal/blake2b/blake2b.h"
 
@@ -106,4 +107,56 @@ namespace argonishche {
         } \
     };
 
+#define BLAKE2B_HASH64_TEST(IS) class TestHash64_Blake2B_##IS { \
+    public: \
+        static bool RunTest() { \
+            uint8_t in[BLAKE2B_OUTBYTES], md[BLAKE2B_OUTBYTES], expected[BLAKE2B_OUTBYTES]; \
+            for (uint32_t seed = 0; seed < 16; ++seed) { \
+                selftest_seq(in, sizeof(in), seed); \
+                Blake2B<InstructionSet::IS> hash(BLAKE2B_OUTBYTES); \
+                hash.Update(in, sizeof(in)); \
+                hash.Final(expected, sizeof(expected)); \
+                Blake2B<InstructionSet::IS>::Hash64(md, in); \
+                if (memcmp(md, expected, BLAKE2B_OUTBYTES) != 0) \
+                    return false; \
+            } \
+            return true; \
+        } \
+    };
+
+    /* Lengths of messages hashed at once by multi-buffer Blake2B, they make lanes finish at different blocks */
+    const size_t b2b_multi_in_len[19] = { 0, 3, 128, 129, 255, 1024, 1, 127, 256, 257, 64, 700, 0, 128, 1000, 5, 383, 384, 385 };
+
+#define BLAKE2B_MULTI_TEST(IS) class TestMulti_Blake2B_##IS { \
+    public: \
+        static bool RunTest() { \
+            uint8_t in[19][1024], md[19][64], expected[64], key[64]; \
+            const uint8_t* pin[19]; \
+            uint8_t* pout[19]; \
+            for (int i = 0; i < 19; ++i) { \
+                selftest_seq(in[i], b2b_multi_in_len[i], i); \
+                pin[i] = in[i]; \
+                pout[i] = md[i]; \
+            } \
+            for (int i = 0; i < 4; ++i) { \
+                size_t outlen = b2b_md_len[i]; \
+                selftest_seq(key, outlen, outlen); \
+                for (size_t keylen = 0; keylen <= outlen; keylen += outlen) { \
+                    Blake2BMulti<InstructionSet::IS> multi(outlen, keylen ? key : nullptr, keylen); \
+                    multi.Hash(pin, b2b_multi_in_len, pout, 19); \
+                    for (int j = 0; j < 19; ++j) { \
+                        std::unique_ptr<Blake2B<InstructionSet::IS>> hash = keylen ? \
+                                std::make_unique<Blake2B<InstructionSet::IS>>(outlen, key, keylen) : \
+                                std::make_unique<Blake2B<InstructionSet::IS>>(outlen); \
+                        hash->Update(in[j], b2b_multi_in_len[j]); \
+                        hash->Final(expected, outlen); \
+                        if (memcmp(md[j], expected, outlen) != 0) \
+                            return false; \
+                    } \
+                } \
+            } \
+            return true; \
+        } \
+    };
+
 }
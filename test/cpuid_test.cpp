@@ -11,6 +11,7 @@ int main(int argc, char** argv) {
     cout << "{" << endl;
     cout_tabbed("Vendor", cpuid::CpuId::GetVendor());
 
+    cout_tabbed("AVX512FVL", cpuid::CpuId::HasAVX512FVL() ? "True" : "False");
     cout_tabbed("AVX2BMI12", cpuid::CpuId::HasAVX2BMI12() ? "True" : "False");
     cout_tabbed("SSE4.1", cpuid::CpuId::HasSSE41() ? "True" : "False");
     cout_tabbed("SSE4.2", cpuid::CpuId::HasSSE42() ? "True" : "False");
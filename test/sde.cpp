@@ -265,6 +265,37 @@ namespace argonishche {
         }
         return true;
     }
+
+    static bool Blake2BMultiTest() {
+        const size_t inlen[11] = { 0, 3, 128, 129, 255, 1024, 1, 127, 256, 0, 385 };
+        uint8_t in[11][1024], md[11][64], expected[64], key[64];
+        const uint8_t* pin[11];
+        uint8_t* pout[11];
+
+        for (uint32_t i = 0; i < 11; ++i) {
+            selftest_seq(in[i], inlen[i], i);
+            pin[i] = in[i];
+            pout[i] = md[i];
+        }
+        selftest_seq(key, sizeof(key), sizeof(key));
+
+        Blake2BFactory factory;
+        InstructionSet maxInstructionSet = factory.GetInstructionSet();
+        for (uint32_t is = 0; is <= (uint32_t)maxInstructionSet; is++) {
+            auto multi = factory.CreateMulti((InstructionSet)is, 48, key, 32);
+            multi->Hash(pin, inlen, pout, 11);
+            for (uint32_t i = 0; i < 11; ++i) {
+                KeyedHash((InstructionSet)is, expected, 48, key, 32, in[i], (uint32_t)inlen[i]);
+                if (memcmp(md[i], expected, 48) != 0) {
+                    std::cout << "Blake2B multi-buffer fail: "
+                              << Utils::InstructionSetToString((InstructionSet)is)
+                              << std::endl;
+                    return false;
+                }
+            }
+        }
+        return true;
+    }
 }
 
 using namespace argonishche;
@@ -280,6 +311,8 @@ int main(int argc, char** argv) {
         return EXIT_FAILURE;
     if (!Blake2BSelfTest())
         return EXIT_FAILURE;
+    if (!Blake2BMultiTest())
+        return EXIT_FAILURE;
     if (!TestTwoPassArgon2(Argon2Type::Argon2_d))
         return EXIT_FAILURE;
     if (!TestTwoPassArgon2(Argon2Type::Argon2_i))
@@ -14,11 +14,23 @@
     ARGON_TEST(IS, Argon2Type::Argon2_d, GenKatResult2d2pass2threads32kb, 2, 32, 2) \
     ARGON_TEST(IS, Argon2Type::Argon2_d, GenKatResult2d2pass4threads64kb, 2, 64, 4) \
     ARGON_TEST(IS, Argon2Type::Argon2_i, GenKatResult2i2pass4threads64kb, 2, 64, 4) \
-    ARGON_TEST(IS, Argon2Type::Argon2_id, GenKatResult2id2pass4threads64kb, 2, 64, 4)
+    ARGON_TEST(IS, Argon2Type::Argon2_id, GenKatResult2id2pass4threads64kb, 2, 64, 4) \
+    ARGON2_BATCH_TEST(IS, Argon2Type::Argon2_d, d1pass, 1, 32, 1) \
+    ARGON2_BATCH_TEST(IS, Argon2Type::Argon2_i, i2pass, 2, 32, 1) \
+    ARGON2_BATCH_TEST(IS, Argon2Type::Argon2_id, id2pass, 2, 32, 1) \
+    ARGON2_BATCH_TEST(IS, Argon2Type::Argon2_d, d2pass4threads64kb, 2, 64, 4) \
+    ARGON2_BATCH_TEST(IS, Argon2Type::Argon2_i, i2pass4threads64kb, 2, 64, 4) \
+    ARGON2_BATCH_TEST(IS, Argon2Type::Argon2_id, id2pass4threads64kb, 2, 64, 4)
 
 #define RUN_ARGON2_TEST(IS, RES) \
     CHECK_RESULT(Test_Argon2_##IS##RES::RunTest());
 
+#define RUN_ARGON2_SINGLE_THREADED_TEST(IS, RES) \
+    CHECK_RESULT(RunSingleThreaded(Test_Argon2_##IS##RES::RunTest));
+
+#define RUN_ARGON2_BATCH_TEST(IS, NAME) \
+    CHECK_RESULT(Test_Argon2Batch_##IS##NAME::RunTest());
+
 #define RUN_ARGON2_TESTS(IS) \
     CHECK_RESULT(Test_Argon2d_1024_##IS::RunTest()); \
     RUN_ARGON2_TEST(IS, GenKatResult) \
@@ -30,14 +42,32 @@
     RUN_ARGON2_TEST(IS, GenKatResult2d2pass2threads32kb) \
     RUN_ARGON2_TEST(IS, GenKatResult2d2pass4threads64kb) \
     RUN_ARGON2_TEST(IS, GenKatResult2i2pass4threads64kb) \
-    RUN_ARGON2_TEST(IS, GenKatResult2id2pass4threads64kb)
+    RUN_ARGON2_TEST(IS, GenKatResult2id2pass4threads64kb) \
+    RUN_ARGON2_SINGLE_THREADED_TEST(IS, GenKatResult2d2pass2threads32kb) \
+    RUN_ARGON2_SINGLE_THREADED_TEST(IS, GenKatResult2d2pass4threads64kb) \
+    RUN_ARGON2_SINGLE_THREADED_TEST(IS, GenKatResult2i2pass4threads64kb) \
+    RUN_ARGON2_SINGLE_THREADED_TEST(IS, GenKatResult2id2pass4threads64kb) \
+    RUN_ARGON2_BATCH_TEST(IS, d1pass) \
+    RUN_ARGON2_BATCH_TEST(IS, i2pass) \
+    RUN_ARGON2_BATCH_TEST(IS, id2pass) \
+    RUN_ARGON2_BATCH_TEST(IS, d2pass4threads64kb) \
+    RUN_ARGON2_BATCH_TEST(IS, i2pass4threads64kb) \
+    RUN_ARGON2_BATCH_TEST(IS, id2pass4threads64kb)
 
 #define DECLARE_BLAKE2B_TESTS(IS) \
     BLAKE2B_ABC_TEST(IS) \
     BLAKE2B_ABC128_TEST(IS) \
-    BLAKE2B_RFC7693_SELFTEST(IS)
+    BLAKE2B_RFC7693_SELFTEST(IS) \
+    BLAKE2B_HASH64_TEST(IS)
 
 #define RUN_BLAKE2B_TESTS(IS) \
     CHECK_RESULT(TestABC_Blake2B_##IS::RunTest()); \
     CHECK_RESULT(TestABC128_Blake2B_##IS::RunTest()); \
-    CHECK_RESULT(TestRFC7693_Blake2B_##IS::RunTest());
+    CHECK_RESULT(TestRFC7693_Blake2B_##IS::RunTest()); \
+    CHECK_RESULT(TestHash64_Blake2B_##IS::RunTest());
+
+#define DECLARE_BLAKE2B_MULTI_TESTS(IS) \
+    BLAKE2B_MULTI_TEST(IS)
+
+#define RUN_BLAKE2B_MULTI_TESTS(IS) \
+    CHECK_RESULT(TestMulti_Blake2B_##IS::RunTest());